@@ -0,0 +1,201 @@
+/**
+ * \file           bench_jitter.c
+ * \brief          Task release jitter benchmark
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#define _POSIX_C_SOURCE 200112L
+#include <pthread.h>
+#include <setjmp.h>
+#include <stdio.h>
+#include <time.h>
+#include "minirtos.h"
+#include "bench_util.h"
+/*****************************************************************************/
+/* Private Defines                                                           */
+/*****************************************************************************/
+#define BENCH_TICK_NS       500000ULL   /* Period of the simulated SysTick */
+#define BENCH_TICK_RING     1024U       /* Tick times kept, a power of two */
+#define BENCH_SAMPLES       2000U       /* Probe runs per scenario */
+#define BENCH_LOAD_TASKS    8U
+/*****************************************************************************/
+/* Private Variables                                                         */
+/*****************************************************************************/
+volatile minirtos_Tick_t glbSysTicks; /* Advanced by the ticker thread */
+static volatile uint64_t glbTickTime[BENCH_TICK_RING]; /* Time at which each tick was counted */
+static volatile bool glbTickerRunning;
+static Task_Descriptor_t glbProbe;
+static Task_Descriptor_t glbLoad[BENCH_LOAD_TASKS];
+static minirtos_Tick_t glbProbeDue;
+static uint64_t glbSamples[BENCH_SAMPLES];
+static volatile uint32_t glbSampleCount;
+static jmp_buf glbExit;
+
+/* Background tasks: interval in ticks and execution time in microseconds */
+static const uint32_t glbLoadInterval[BENCH_LOAD_TASKS] = { 2, 3, 5, 7, 11, 13, 17, 19 };
+static const uint32_t glbLoadCost[BENCH_LOAD_TASKS] = { 20, 40, 60, 80, 100, 120, 150, 200 };
+/*****************************************************************************/
+/* Private Functions                                                         */
+/*****************************************************************************/
+/* Simulated SysTick interrupt, records when each tick is counted */
+static void *bench_Ticker(void *ptrArgument)
+{
+    uint64_t next = bench_Now();
+
+    (void)ptrArgument;
+    while (glbTickerRunning)
+    {
+        struct timespec wake;
+        minirtos_Tick_t tick;
+
+        next += BENCH_TICK_NS;
+        wake.tv_sec = (time_t)(next / 1000000000ULL);
+        wake.tv_nsec = (long)(next % 1000000000ULL);
+        (void)clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, NULL);
+
+        tick = glbSysTicks + 1U;
+        glbTickTime[tick & (BENCH_TICK_RING - 1U)] = bench_Now();
+        __atomic_thread_fence(__ATOMIC_RELEASE);
+        glbSysTicks = tick;
+    }
+
+    return NULL;
+}
+
+/* Periodic task of one tick, measures how late it starts after its release tick */
+static void bench_Probe(void)
+{
+    uint64_t now = bench_Now();
+
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    glbSamples[glbSampleCount] = now - glbTickTime[glbProbeDue & (BENCH_TICK_RING - 1U)];
+    /* The next release has already been planned */
+    glbProbeDue = glbProbe.plannedTask;
+    if (++glbSampleCount == BENCH_SAMPLES)
+    {
+        longjmp(glbExit, 1);
+    }
+}
+
+#define BENCH_LOAD_TASK(index) \
+    static void bench_Load##index(void) { bench_Spin(glbLoadCost[index] * 1000ULL); }
+BENCH_LOAD_TASK(0) BENCH_LOAD_TASK(1) BENCH_LOAD_TASK(2) BENCH_LOAD_TASK(3)
+BENCH_LOAD_TASK(4) BENCH_LOAD_TASK(5) BENCH_LOAD_TASK(6) BENCH_LOAD_TASK(7)
+
+static const gptr_Task_Function glbLoadTask[BENCH_LOAD_TASKS] = {
+    bench_Load0, bench_Load1, bench_Load2, bench_Load3,
+    bench_Load4, bench_Load5, bench_Load6, bench_Load7
+};
+
+/*****************************************************************************
+ * @brief Run the probe, with or without background tasks, and print its start latency.
+ *
+ * @param ptrName       Name of the scenario.
+ *
+ * @param numberOfLoads Number of background tasks.
+ *****************************************************************************/
+static void bench_Jitter(const char *ptrName, uint8_t numberOfLoads)
+{
+    static const uint64_t bucketLimit[] = { 10, 50, 100, 200, 500 };
+    uint32_t bucket[(sizeof(bucketLimit) / sizeof(bucketLimit[0])) + 1U] = { 0 };
+    pthread_t ticker;
+
+    minirtos_Init();
+    if (!minirtos_AddTask(&glbProbe, bench_Probe, 1, TASK_SCHEDULED))
+    {
+        fprintf(stderr, "minirtos_AddTask failed for the probe\n");
+        exit(EXIT_FAILURE);
+    }
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+    (void)minirtos_SetTaskPriority(&glbProbe, 0);
+#endif
+    for (uint8_t index = 0; index < numberOfLoads; index++)
+    {
+        if (!minirtos_AddTask(&glbLoad[index], glbLoadTask[index], glbLoadInterval[index], TASK_SCHEDULED))
+        {
+            fprintf(stderr, "minirtos_AddTask failed for load %u\n", index);
+            exit(EXIT_FAILURE);
+        }
+    }
+    glbProbeDue = glbProbe.plannedTask;
+    glbTickTime[0] = bench_Now();
+    glbSampleCount = 0;
+
+    glbTickerRunning = true;
+    if (pthread_create(&ticker, NULL, bench_Ticker, NULL) != 0)
+    {
+        fprintf(stderr, "ticker thread not started\n");
+        exit(EXIT_FAILURE);
+    }
+    if (setjmp(glbExit) == 0)
+    {
+        minirtos_Scheduler();
+    }
+    glbTickerRunning = false;
+    (void)pthread_join(ticker, NULL);
+
+    for (uint32_t sample = 0; sample < BENCH_SAMPLES; sample++)
+    {
+        uint8_t index = 0;
+
+        glbSamples[sample] /= 1000U;
+        while ((index < (sizeof(bucketLimit) / sizeof(bucketLimit[0]))) && (glbSamples[sample] >= bucketLimit[index]))
+        {
+            index++;
+        }
+        bucket[index]++;
+    }
+    printf("%-14s %7llu %7llu %7llu %7llu %7llu |", ptrName,
+           (unsigned long long)bench_Percentile(glbSamples, BENCH_SAMPLES, 0),
+           (unsigned long long)bench_Percentile(glbSamples, BENCH_SAMPLES, 50),
+           (unsigned long long)bench_Percentile(glbSamples, BENCH_SAMPLES, 90),
+           (unsigned long long)bench_Percentile(glbSamples, BENCH_SAMPLES, 99),
+           (unsigned long long)bench_Percentile(glbSamples, BENCH_SAMPLES, 100));
+    for (size_t index = 0; index < (sizeof(bucket) / sizeof(bucket[0])); index++)
+    {
+        printf(" %6u", bucket[index]);
+    }
+    printf("\n");
+}
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+int main(void)
+{
+    printf("Release jitter of a 1 tick task, %s (us after the tick, %u runs, %llu us tick)\n",
+           BENCH_VARIANT, BENCH_SAMPLES, (unsigned long long)(BENCH_TICK_NS / 1000U));
+    printf("%-14s %7s %7s %7s %7s %7s | %6s %6s %6s %6s %6s %6s\n", "scenario", "min", "p50", "p90", "p99", "max",
+           "<10", "<50", "<100", "<200", "<500", ">=500");
+    bench_Jitter("probe only", 0);
+    bench_Jitter("8 load tasks", BENCH_LOAD_TASKS);
+
+    return 0;
+}
+/************************************END*****************************************/
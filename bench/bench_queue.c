@@ -0,0 +1,149 @@
+/**
+ * \file           bench_queue.c
+ * \brief          Queue throughput benchmark
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#include <stdio.h>
+#include "minirtos.h"
+#include "bench_util.h"
+/*****************************************************************************/
+/* Private Defines                                                           */
+/*****************************************************************************/
+#define BENCH_QUEUE_DEPTH       64U     /* Elements of the benchmarked queues */
+#define BENCH_QUEUE_ELEMENTS    512000UL /* Elements sent and received per measurement */
+#define BENCH_ELEMENT_MAX       256U
+/*****************************************************************************/
+/* Private Variables                                                         */
+/*****************************************************************************/
+volatile minirtos_Tick_t glbSysTicks;
+static uint8_t glbBuffer[BENCH_QUEUE_DEPTH * BENCH_ELEMENT_MAX];
+static uint8_t glbMessages[BENCH_QUEUE_DEPTH * BENCH_ELEMENT_MAX];
+static const uint16_t glbElementSizes[] = { 1, 4, 8, 16, 32, 64, 128, 256 };
+
+typedef enum {
+    BENCH_QUEUE_LOCKED = 0, /* minirtos_Queue_Send() / minirtos_Queue_Receive() */
+    BENCH_QUEUE_SPSC,       /* Same on a single producer / single consumer queue */
+    BENCH_QUEUE_BLOCK       /* minirtos_Queue_SendBlock() / minirtos_Queue_ReceiveBlock() */
+} Bench_Queue_e;
+/*****************************************************************************/
+/* Private Functions                                                         */
+/*****************************************************************************/
+/*****************************************************************************
+ * @brief Measure the time to send and receive one element.
+ *
+ * @details The queue is filled and drained in turn, so every call succeeds.
+ *
+ * @param mode          Queue type and functions.
+ *
+ * @param elementSize   Size of the elements in bytes.
+ *
+ * @return Nanoseconds per element sent and received, best of BENCH_REPEAT measurements
+ *****************************************************************************/
+static double bench_Queue(Bench_Queue_e mode, uint16_t elementSize)
+{
+    double best = 0.0;
+
+    for (uint8_t repeat = 0; repeat < BENCH_REPEAT; repeat++)
+    {
+        Queue_Descriptor_t queue;
+        uint64_t start;
+        double perElement;
+        bool created;
+
+        if (mode == BENCH_QUEUE_SPSC)
+        {
+            created = minirtos_Queue_CreateSPSC(&queue, glbBuffer, elementSize, BENCH_QUEUE_DEPTH);
+        }
+        else
+        {
+            created = minirtos_Queue_Create(&queue, glbBuffer, elementSize, BENCH_QUEUE_DEPTH);
+        }
+        if (!created)
+        {
+            fprintf(stderr, "queue creation failed for %u byte elements\n", elementSize);
+            exit(EXIT_FAILURE);
+        }
+
+        start = bench_Now();
+        for (uint32_t sent = 0; sent < BENCH_QUEUE_ELEMENTS; sent += BENCH_QUEUE_DEPTH)
+        {
+            if (mode == BENCH_QUEUE_BLOCK)
+            {
+                (void)minirtos_Queue_SendBlock(&queue, glbMessages, BENCH_QUEUE_DEPTH);
+                (void)minirtos_Queue_ReceiveBlock(&queue, glbMessages, BENCH_QUEUE_DEPTH);
+                continue;
+            }
+            for (uint16_t index = 0; index < BENCH_QUEUE_DEPTH; index++)
+            {
+                (void)minirtos_Queue_Send(&queue, &glbMessages[index * elementSize]);
+            }
+            for (uint16_t index = 0; index < BENCH_QUEUE_DEPTH; index++)
+            {
+                (void)minirtos_Queue_Receive(&queue, &glbMessages[index * elementSize]);
+            }
+        }
+        perElement = (double)(bench_Now() - start) / (double)BENCH_QUEUE_ELEMENTS;
+        if (minirtos_Queue_Count(&queue) != 0)
+        {
+            fprintf(stderr, "queue not drained for %u byte elements\n", elementSize);
+            exit(EXIT_FAILURE);
+        }
+        if ((repeat == 0) || (perElement < best))
+        {
+            best = perElement;
+        }
+    }
+
+    return best;
+}
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+int main(void)
+{
+    minirtos_Init();
+
+    printf("Queue send + receive, %s (ns per element, best of %u, depth %u)\n",
+           BENCH_VARIANT, BENCH_REPEAT, BENCH_QUEUE_DEPTH);
+    printf("%8s %10s %10s %10s %14s\n", "bytes", "locked", "spsc", "block", "locked [MB/s]");
+    for (size_t index = 0; index < (sizeof(glbElementSizes) / sizeof(glbElementSizes[0])); index++)
+    {
+        uint16_t elementSize = glbElementSizes[index];
+        double locked = bench_Queue(BENCH_QUEUE_LOCKED, elementSize);
+
+        printf("%8u %10.1f %10.1f %10.1f %14.1f\n", elementSize, locked,
+               bench_Queue(BENCH_QUEUE_SPSC, elementSize), bench_Queue(BENCH_QUEUE_BLOCK, elementSize),
+               ((double)elementSize * 1000.0) / locked);
+    }
+
+    return 0;
+}
+/************************************END*****************************************/
@@ -0,0 +1,198 @@
+/**
+ * \file           bench_scheduler.c
+ * \brief          Scheduler dispatch benchmark
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#include <setjmp.h>
+#include <stdio.h>
+#include "minirtos.h"
+#include "bench_util.h"
+/*****************************************************************************/
+/* Private Defines                                                           */
+/*****************************************************************************/
+#define BENCH_DISPATCHES    200000UL /* Task runs per measurement */
+#define BENCH_SHARED_PERIOD 10U      /* Interval of the tasks sharing their due tick */
+
+/* Task sets measured */
+#define BENCH_ALL_DUE       0U       /* Every task always due */
+#define BENCH_ONE_PER_TICK  1U       /* Periodic tasks, exactly one due per tick */
+#define BENCH_SHARED_TICK   2U       /* Periodic tasks all due on the same tick */
+/*****************************************************************************/
+/* Private Variables                                                         */
+/*****************************************************************************/
+volatile minirtos_Tick_t glbSysTicks; /* Simulated tick, advanced by the task bodies */
+static Task_Descriptor_t glbTasks[MAX_TASKS_NUMBER];
+static uint8_t glbPhase[MAX_TASKS_NUMBER];
+static jmp_buf glbExit;
+static volatile uint32_t glbRuns;
+static uint32_t glbGroupRuns;
+static uint16_t glbGroupSize;
+static volatile uint64_t glbStart;
+static const uint16_t glbTaskCounts[] = { 1, 4, 16, 64, 128, 255 };
+/*****************************************************************************/
+/* Private Functions                                                         */
+/*****************************************************************************/
+/* Body of the tasks which are always due */
+static void bench_TaskDue(void)
+{
+    if (++glbRuns == BENCH_DISPATCHES)
+    {
+        longjmp(glbExit, 1);
+    }
+}
+
+/* Body of the tasks due one per tick, the tick elapses while the task runs */
+static void bench_TaskTick(void)
+{
+    glbSysTicks++;
+    bench_TaskDue();
+}
+
+/* Body of the tasks sharing their due tick, the last one of the group moves to the next period */
+static void bench_TaskShared(void)
+{
+    if (++glbGroupRuns == glbGroupSize)
+    {
+        glbGroupRuns = 0;
+        glbSysTicks += BENCH_SHARED_PERIOD;
+    }
+    bench_TaskDue();
+}
+
+/* Shuffle the phases, so the due task is never simply the next one in the list */
+static void bench_Shuffle(uint16_t numberOfTasks)
+{
+    uint32_t seed = 12345U;
+
+    for (uint16_t index = 0; index < numberOfTasks; index++)
+    {
+        glbPhase[index] = (uint8_t)index;
+    }
+    for (uint16_t index = numberOfTasks; index > 1; index--)
+    {
+        uint8_t swap;
+        uint16_t other;
+
+        seed = (seed * 1103515245U) + 12345U;
+        other = (uint16_t)((seed >> 16) % index);
+        swap = glbPhase[index - 1];
+        glbPhase[index - 1] = glbPhase[other];
+        glbPhase[other] = swap;
+    }
+}
+
+/* Run the scheduler until BENCH_DISPATCHES task runs, returns the time taken */
+static uint64_t bench_Run(void)
+{
+    glbRuns = 0;
+    glbStart = bench_Now();
+    if (setjmp(glbExit) == 0)
+    {
+        minirtos_Scheduler();
+    }
+
+    return bench_Now() - glbStart;
+}
+
+/*****************************************************************************
+ * @brief Measure the time per task run of the scheduler.
+ *
+ * @param numberOfTasks   Number of tasks in the scheduler.
+ *
+ * @param taskSet         BENCH_ALL_DUE, BENCH_ONE_PER_TICK or BENCH_SHARED_TICK.
+ *
+ * @return Nanoseconds per task run, best of BENCH_REPEAT measurements
+ *****************************************************************************/
+static double bench_Dispatch(uint16_t numberOfTasks, uint8_t taskSet)
+{
+    double best = 0.0;
+
+    bench_Shuffle(numberOfTasks);
+    for (uint8_t repeat = 0; repeat < BENCH_REPEAT; repeat++)
+    {
+        double perRun;
+
+        minirtos_Init();
+        for (uint16_t index = 0; index < numberOfTasks; index++)
+        {
+            bool added;
+
+            if (taskSet == BENCH_ONE_PER_TICK)
+            {
+                /* Planned at phase + period, then every period */
+                glbSysTicks = glbPhase[index];
+                added = minirtos_AddTask(&glbTasks[index], bench_TaskTick, numberOfTasks, TASK_SCHEDULED);
+            }
+            else if (taskSet == BENCH_SHARED_TICK)
+            {
+                glbSysTicks = 0;
+                added = minirtos_AddTask(&glbTasks[index], bench_TaskShared, BENCH_SHARED_PERIOD, TASK_SCHEDULED);
+            }
+            else
+            {
+                added = minirtos_AddTask(&glbTasks[index], bench_TaskDue, 0, TASK_RUN_NOW);
+            }
+            if (!added)
+            {
+                fprintf(stderr, "minirtos_AddTask failed for task %u\n", index);
+                exit(EXIT_FAILURE);
+            }
+        }
+        glbSysTicks = (taskSet == BENCH_SHARED_TICK) ? BENCH_SHARED_PERIOD : numberOfTasks;
+        glbGroupRuns = 0;
+        glbGroupSize = numberOfTasks;
+        perRun = (double)bench_Run() / (double)BENCH_DISPATCHES;
+        if ((repeat == 0) || (perRun < best))
+        {
+            best = perRun;
+        }
+    }
+
+    return best;
+}
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+int main(void)
+{
+    printf("Scheduler dispatch, %s (ns per task run, best of %u)\n", BENCH_VARIANT, BENCH_REPEAT);
+    printf("%8s %12s %18s %18s\n", "tasks", "all due", "one due per tick", "all due same tick");
+    for (size_t index = 0; index < (sizeof(glbTaskCounts) / sizeof(glbTaskCounts[0])); index++)
+    {
+        uint16_t numberOfTasks = glbTaskCounts[index];
+
+        printf("%8u %12.1f %18.1f %18.1f\n", numberOfTasks, bench_Dispatch(numberOfTasks, BENCH_ALL_DUE),
+               bench_Dispatch(numberOfTasks, BENCH_ONE_PER_TICK), bench_Dispatch(numberOfTasks, BENCH_SHARED_TICK));
+    }
+
+    return 0;
+}
+/************************************END*****************************************/
@@ -0,0 +1,97 @@
+/**
+ * \file           bench_util.c
+ * \brief          Benchmark helpers source file
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include <stdlib.h>
+#include <time.h>
+#include "bench_util.h"
+/*****************************************************************************/
+/* Private Functions                                                         */
+/*****************************************************************************/
+static int bench_Compare(const void *ptrA, const void *ptrB)
+{
+    uint64_t a = *(const uint64_t *)ptrA;
+    uint64_t b = *(const uint64_t *)ptrB;
+
+    return (a > b) - (a < b);
+}
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+/*****************************************************************************
+ * @brief Monotonic time in nanoseconds.
+ *****************************************************************************/
+uint64_t bench_Now(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*****************************************************************************
+ * @brief Busy wait, stands for the execution time of a task body.
+ *
+ * @param nanoseconds   Time to spend.
+ *****************************************************************************/
+void bench_Spin(uint64_t nanoseconds)
+{
+    uint64_t start = bench_Now();
+
+    while ((bench_Now() - start) < nanoseconds)
+    {
+    }
+}
+
+/*****************************************************************************
+ * @brief Sort the samples and return the given percentile.
+ *
+ * @param ptrSamples    Samples, sorted in place.
+ *
+ * @param count         Number of samples.
+ *
+ * @param percent       Percentile from 0 (minimum) to 100 (maximum).
+ *
+ * @return Sample below which percent % of the samples lie, 0 without samples
+ *****************************************************************************/
+uint64_t bench_Percentile(uint64_t *ptrSamples, uint32_t count, uint32_t percent)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    qsort(ptrSamples, count, sizeof(uint64_t), bench_Compare);
+
+    return ptrSamples[((uint64_t)(count - 1) * percent) / 100U];
+}
+/************************************END*****************************************/
@@ -0,0 +1,71 @@
+/**
+ * \file           bench_util.h
+ * \brief          Benchmark helpers header file
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+
+#ifndef BENCH_UTIL_H_
+#define BENCH_UTIL_H_
+
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#include <stdint.h>
+/*****************************************************************************/
+/* Private Defines                                                           */
+/*****************************************************************************/
+/**
+ * @brief Scheduler configuration a benchmark was built with, set by CMake.
+ */
+#ifndef BENCH_VARIANT
+#define BENCH_VARIANT   "default"
+#endif
+
+/**
+ * @brief Number of times a measurement is repeated, the fastest one is reported.
+ */
+#define BENCH_REPEAT    5
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+/**
+ * @brief Monotonic time in nanoseconds.
+ */
+uint64_t bench_Now(void);
+
+/**
+ * @brief Busy wait, stands for the execution time of a task body.
+ */
+void bench_Spin(uint64_t nanoseconds);
+
+/**
+ * @brief Sort the samples and return the given percentile (0 to 100).
+ */
+uint64_t bench_Percentile(uint64_t *ptrSamples, uint32_t count, uint32_t percent);
+
+#endif /* BENCH_UTIL_H_ */
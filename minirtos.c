@@ -36,471 +36,4927 @@
 /* Private Variables                                                         */
 /*****************************************************************************/
 uint8_t glbInitialized; /* To verify whether scheduler is started by User or not */
-uint8_t glbNumberOfTasks; /* Counter for the scheduler to get user defined tasks*/
+Core_Descriptor_t glbCore[MINIRTOS_CFG_CORES]; /* Scheduler instance of each core */
 
-Task_Descriptor_t *gptrTaskSchedule; /*Pointer to the next task that is scheduled to run*/
-Task_Descriptor_t *gptrTaskFirst = NULL; /* Pointer to the first task to the scheduler*/
+#if (MINIRTOS_CFG_TASK_POOL_SIZE > 0)
+Task_Descriptor_t glbTaskPool[MINIRTOS_CFG_TASK_POOL_SIZE]; /* Statically allocated task descriptors */
+Task_Descriptor_t *gptrTaskPoolFree; /* Free descriptors of the pool, linked through gptrTaskNext */
+#endif
 
+#if (MINIRTOS_CFG_HRTIMER == 1)
+HrTask_Descriptor_t *gptrHrTaskFirst; /* High resolution timer tasks sorted by due time */
+#endif
+
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+gptr_Budget_Hook gptrBudgetHook = NULL; /* User hook called on a budget overrun */
+gptr_Watchdog_Hook gptrWatchdogHook = NULL; /* User hook kicking the hardware watchdog */
+#endif
+
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+Thread_Descriptor_t *gptrThreadTable[MINIRTOS_THREAD_PRIORITIES]; /* Created threads, indexed by priority */
+Thread_Descriptor_t *gptrThreadCurrent; /* Running thread, NULL for the cooperative context */
+uint32_t *gptrMainStack; /* Saved stack pointer of the cooperative context (MSP) */
+volatile uint32_t glbThreadReady; /* Bit (31 - priority) is set while the thread is ready */
+volatile uint32_t glbThreadDelayed; /* Bit (31 - priority) is set while the thread is delayed */
+#endif
+
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+gptr_Idle_Hook gptrIdleHook = NULL; /* User hook called when there is nothing to run */
+gptr_Sleep_Hook gptrSleepHook = minirtos_SysTickSleep; /* Hook suppressing the tick while idle */
+volatile bool glbTaskChanged; /* Set when a task changed while the scheduler prepared to sleep */
+#endif
+
+/*****************************************************************************/
+/* Private Functions                                                         */
+/*****************************************************************************/
+/*****************************************************************************
+ * @brief Check whether a task takes part in the scheduling.
+ *
+ * @param ptrTask   Descriptor of the task.
+ *
+ * @return True unless the task is paused or invalid
+ *****************************************************************************/
+static bool minirtos_IsTaskActive(const Task_Descriptor_t *ptrTask)
+{
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    if (ptrTask->taskStatus == TASK_EVENT)
+    {
+        /* Event tasks are only active while an event is pending */
+        return (ptrTask->taskEvents != 0);
+    }
+#endif
+    return ((ptrTask->taskStatus > TASK_PAUSE) && (ptrTask->taskStatus != TASK_NOT_FOUND));
+}
+
+/*****************************************************************************
+ * @brief Check whether the planned time of a task has been reached.
+ *
+ * @param ptrTask   Descriptor of the task.
+ *
+ * @param sysTicks  Current tick.
+ *
+ * @return True if the task has to be executed
+ *****************************************************************************/
+static bool minirtos_IsTaskDue(const Task_Descriptor_t *ptrTask, minirtos_Tick_t sysTicks)
+{
+    /*this trick overrun the overflow of System ticks*/
+    minirtos_TickDiff_t elapsedTime = (minirtos_TickDiff_t)(ptrTask->plannedTask - sysTicks);
+
+    return (elapsedTime <= ZERO);
+}
+
+/*****************************************************************************
+ * @brief Check whether a task belongs to the scheduler instance of the calling core.
+ *
+ * @details The lists of a core are only changed by that core, a task of another
+ *   core can only be added or notified through the mailboxes.
+ *
+ * @param ptrTask   Descriptor of the task.
+ *
+ * @return True if the task runs on the calling core
+ *****************************************************************************/
+static bool minirtos_IsTaskLocal(const Task_Descriptor_t *ptrTask)
+{
+#if (MINIRTOS_CFG_CORES > 1)
+    return (ptrTask->taskCore == MINIRTOS_CORE_ID());
+#else
+    (void)ptrTask;
+    return true;
+#endif
+}
+
+#if (MINIRTOS_CFG_TRACE_SIZE > 0)
+/*****************************************************************************
+ * @brief Record a trace event in the ring of the calling core.
+ *
+ * @details The event is dropped and counted while the ring is full, so the events
+ *   already recorded are sent out unchanged.
+ *
+ * @param eventType     Trace_Event_e of the event.
+ *
+ * @param eventObject   Object of the event, truncated to 24 bits.
+ *****************************************************************************/
+static void minirtos_Trace_Record(uint8_t eventType, uint32_t eventObject)
+{
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+
+    MINIRTOS_ENTER_CRITICAL();
+    if ((ptrCore->traceTail - ptrCore->traceHead) < MINIRTOS_CFG_TRACE_SIZE)
+    {
+        Trace_Event_t *ptrEvent = &ptrCore->traceEvents[ptrCore->traceTail & (MINIRTOS_CFG_TRACE_SIZE - 1)];
+
+        ptrEvent->timestamp = MINIRTOS_TRACE_TIMESTAMP();
+        ptrEvent->eventData = ((uint32_t)eventType << MINIRTOS_TRACE_TYPE_SHIFT) | (eventObject & MINIRTOS_TRACE_OBJECT_MASK);
+        ptrCore->traceTail++;
+    }
+    else
+    {
+        ptrCore->traceLost++;
+    }
+    MINIRTOS_EXIT_CRITICAL();
+}
+
+#define MINIRTOS_TRACE(eventType, ptrObject)    minirtos_Trace_Record((eventType), (uint32_t)(uintptr_t)(ptrObject))
+#else
+#define MINIRTOS_TRACE(eventType, ptrObject)    ((void)0)
+#endif
+
+/*****************************************************************************
+ * @brief Call the body of a task.
+ *
+ * @details A body taking a context is stored as a plain task function and called
+ *   back with its own type, the context telling both kinds apart.
+ *
+ * @param ptrTask   Descriptor of the task.
+ *****************************************************************************/
+static void minirtos_CallTask(const Task_Descriptor_t *ptrTask)
+{
+    MINIRTOS_TRACE(MINIRTOS_TRACE_TASK_START, ptrTask);
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+    if (ptrTask->taskContext != NULL)
+    {
+        ((gptr_Task_Context_Function)ptrTask->taskPointer)(ptrTask->taskContext);
+    }
+    else
+#endif
+    {
+        ptrTask->taskPointer();
+    }
+    MINIRTOS_TRACE(MINIRTOS_TRACE_TASK_END, ptrTask);
+}
+
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+/*****************************************************************************
+ * @brief Compare two tasks of the timer list.
+ *
+ * @details The difference is evaluated as signed so the order stays right
+ *   when plannedTask wraps around.
+ *
+ * @return True if ptrTaskA is planned before ptrTaskB
+ *****************************************************************************/
+static bool minirtos_Heap_Before(const Task_Descriptor_t *ptrTaskA, const Task_Descriptor_t *ptrTaskB)
+{
+    return ((minirtos_TickDiff_t)(ptrTaskA->plannedTask - ptrTaskB->plannedTask) < ZERO);
+}
+
+/*****************************************************************************
+ * @brief Store a task at the given position of the timer list.
+ *****************************************************************************/
+static void minirtos_Heap_Place(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask, uint8_t index)
+{
+    ptrCore->gptrTaskHeap[index] = ptrTask;
+    ptrTask->heapIndex = index;
+}
+
+/*****************************************************************************
+ * @brief Move a task towards the root until its parent is planned earlier.
+ *****************************************************************************/
+static void minirtos_Heap_SiftUp(Core_Descriptor_t *ptrCore, uint8_t index)
+{
+    Task_Descriptor_t *ptrTask = ptrCore->gptrTaskHeap[index];
+
+    while (index > 0)
+    {
+        uint8_t parent = (uint8_t)((index - 1) / 2);
+
+        if (!minirtos_Heap_Before(ptrTask, ptrCore->gptrTaskHeap[parent]))
+        {
+            break;
+        }
+        minirtos_Heap_Place(ptrCore, ptrCore->gptrTaskHeap[parent], index);
+        index = parent;
+    }
+    minirtos_Heap_Place(ptrCore, ptrTask, index);
+}
+
+/*****************************************************************************
+ * @brief Move a task towards the leaves until its children are planned later.
+ *****************************************************************************/
+static void minirtos_Heap_SiftDown(Core_Descriptor_t *ptrCore, uint8_t index)
+{
+    Task_Descriptor_t *ptrTask = ptrCore->gptrTaskHeap[index];
+
+    while (1)
+    {
+        uint16_t child = (uint16_t)((2 * index) + 1);
+
+        if (child >= ptrCore->heapCount)
+        {
+            break;
+        }
+        if (((child + 1) < ptrCore->heapCount) && minirtos_Heap_Before(ptrCore->gptrTaskHeap[child + 1], ptrCore->gptrTaskHeap[child]))
+        {
+            child++;
+        }
+        if (!minirtos_Heap_Before(ptrCore->gptrTaskHeap[child], ptrTask))
+        {
+            break;
+        }
+        minirtos_Heap_Place(ptrCore, ptrCore->gptrTaskHeap[child], index);
+        index = (uint8_t)child;
+    }
+    minirtos_Heap_Place(ptrCore, ptrTask, index);
+}
+
+/*****************************************************************************
+ * @brief Insert a task in the timer list or restore the order after its
+ *        plannedTask has changed.
+ *****************************************************************************/
+static void minirtos_Heap_Update(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    if (ptrTask->heapIndex == MINIRTOS_HEAP_INVALID)
+    {
+        minirtos_Heap_Place(ptrCore, ptrTask, ptrCore->heapCount);
+        ptrCore->heapCount++;
+    }
+    minirtos_Heap_SiftUp(ptrCore, ptrTask->heapIndex);
+    minirtos_Heap_SiftDown(ptrCore, ptrTask->heapIndex);
+}
+
+/*****************************************************************************
+ * @brief Take a task out of the timer list.
+ *****************************************************************************/
+static void minirtos_Heap_Remove(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    uint8_t index = ptrTask->heapIndex;
+
+    if (index == MINIRTOS_HEAP_INVALID)
+    {
+        return;
+    }
+    ptrTask->heapIndex = MINIRTOS_HEAP_INVALID;
+    ptrCore->heapCount--;
+
+    if (index != ptrCore->heapCount)
+    {
+        /* Fill the hole with the last task of the heap and restore the order */
+        Task_Descriptor_t *ptrLastTask = ptrCore->gptrTaskHeap[ptrCore->heapCount];
+
+        minirtos_Heap_Place(ptrCore, ptrLastTask, index);
+        minirtos_Heap_SiftUp(ptrCore, index);
+        minirtos_Heap_SiftDown(ptrCore, ptrLastTask->heapIndex);
+    }
+}
+#endif
+
+#if (MINIRTOS_READY_LEVELS > 0)
+/*****************************************************************************
+ * @brief Get the ready ring of a task.
+ *
+ * @return Priority of the task, 0 when all tasks share a single ring (EDF)
+ *****************************************************************************/
+static uint8_t minirtos_Ready_Level(const Task_Descriptor_t *ptrTask)
+{
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+    return ptrTask->taskPriority;
+#else
+    (void)ptrTask;
+    return 0;
+#endif
+}
+
+/*****************************************************************************
+ * @brief Append a due task to the ready ring of its priority.
+ *
+ * @details In EDF mode the ring is kept ordered by absolute deadline instead,
+ *   tasks with the same deadline stay in arrival order.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_Ready_Push(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    uint8_t priority = minirtos_Ready_Level(ptrTask);
+    Task_Descriptor_t *ptrFirst = ptrCore->gptrReadyFirst[priority];
+    Task_Descriptor_t *ptrNext = ptrFirst;
+
+#if (MINIRTOS_CFG_EDF == 1)
+    /* The task is released at its planned start */
+    ptrTask->absoluteDeadline = ptrTask->plannedTask + ptrTask->taskDeadline;
+#endif
+
+    if (ptrFirst == NULL)
+    {
+        /* First ready task of this priority */
+        ptrCore->gptrReadyFirst[priority] = ptrTask;
+        ptrTask->gptrReadyNext = ptrTask;
+        ptrTask->gptrReadyPrev = ptrTask;
+        ptrCore->readyBitmap |= (0x80000000UL >> priority);
+        return;
+    }
+
+#if (MINIRTOS_CFG_EDF == 1)
+    /* Find the first ready task with a later deadline */
+    do
+    {
+        if ((minirtos_TickDiff_t)(ptrTask->absoluteDeadline - ptrNext->absoluteDeadline) < ZERO)
+        {
+            break;
+        }
+        ptrNext = ptrNext->gptrReadyNext;
+    } while (ptrNext != ptrFirst);
+#endif
+
+    /* Insert before ptrNext, behind the last ready task if the whole ring has been passed,
+     * so a priority level is served round-robin */
+    ptrTask->gptrReadyPrev = ptrNext->gptrReadyPrev;
+    ptrTask->gptrReadyNext = ptrNext;
+    ptrNext->gptrReadyPrev->gptrReadyNext = ptrTask;
+    ptrNext->gptrReadyPrev = ptrTask;
+
+#if (MINIRTOS_CFG_EDF == 1)
+    if ((ptrNext == ptrFirst) && ((minirtos_TickDiff_t)(ptrTask->absoluteDeadline - ptrFirst->absoluteDeadline) < ZERO))
+    {
+        /* Nearest deadline of all the ready tasks */
+        ptrCore->gptrReadyFirst[priority] = ptrTask;
+    }
+#endif
+}
+
+/*****************************************************************************
+ * @brief Take a task out of the ready ring of its priority.
+ *
+ * @note To be called inside a critical section. Does nothing if the task is
+ *       not ready.
+ *****************************************************************************/
+static void minirtos_Ready_Remove(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    uint8_t priority = minirtos_Ready_Level(ptrTask);
+
+    if (ptrTask->gptrReadyPrev == NULL)
+    {
+        return;
+    }
+    if (ptrTask->gptrReadyNext == ptrTask)
+    {
+        /* Last ready task of this priority */
+        ptrCore->gptrReadyFirst[priority] = NULL;
+        ptrCore->readyBitmap &= ~(0x80000000UL >> priority);
+    }
+    else
+    {
+        ptrTask->gptrReadyPrev->gptrReadyNext = ptrTask->gptrReadyNext;
+        ptrTask->gptrReadyNext->gptrReadyPrev = ptrTask->gptrReadyPrev;
+        if (ptrCore->gptrReadyFirst[priority] == ptrTask)
+        {
+            ptrCore->gptrReadyFirst[priority] = ptrTask->gptrReadyNext;
+        }
+    }
+    ptrTask->gptrReadyNext = NULL;
+    ptrTask->gptrReadyPrev = NULL;
+}
+
+/*****************************************************************************
+ * @brief Take the next due task of the highest ready priority.
+ *
+ * @return Task to run, NULL if no task is ready
+ *****************************************************************************/
+static Task_Descriptor_t *minirtos_Ready_PopHighest(Core_Descriptor_t *ptrCore)
+{
+    Task_Descriptor_t *ptrTask = NULL;
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrCore->readyBitmap != 0)
+    {
+        /* The highest priority is the most significant bit of the bitmap */
+        ptrTask = ptrCore->gptrReadyFirst[MINIRTOS_CLZ(ptrCore->readyBitmap)];
+        minirtos_Ready_Remove(ptrCore, ptrTask);
+    }
+    MINIRTOS_EXIT_CRITICAL();
+
+    return ptrTask;
+}
+
+/*****************************************************************************
+ * @brief Move the tasks which became due into the ready rings.
+ *
+ * @details In timer list mode the due tasks are taken from the root of the heap,
+ *   otherwise the task list is scanned once per tick.
+ *****************************************************************************/
+static void minirtos_Ready_Release(Core_Descriptor_t *ptrCore)
+{
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+    bool released;
+
+    do
+    {
+        MINIRTOS_ENTER_CRITICAL();
+        Task_Descriptor_t *ptrTask = (ptrCore->heapCount != 0) ? ptrCore->gptrTaskHeap[0] : NULL;
+
+        released = ((ptrTask != NULL) && minirtos_IsTaskDue(ptrTask, ptrCore->passTicks));
+        if (released)
+        {
+            minirtos_Heap_Remove(ptrCore, ptrTask);
+            minirtos_Ready_Push(ptrCore, ptrTask);
+        }
+        MINIRTOS_EXIT_CRITICAL();
+    } while (released);
+#else
+    Task_Descriptor_t *ptrTask = ptrCore->gptrTaskFirst;
+
+    /* Tasks only become due when the tick changes, changed tasks are released by minirtos_TaskChanged() */
+    if ((ptrCore->passTicks == ptrCore->releaseTick) || (ptrTask == NULL))
+    {
+        return;
+    }
+    ptrCore->releaseTick = ptrCore->passTicks;
+    do
+    {
+        if ((ptrTask->gptrReadyPrev == NULL) && minirtos_IsTaskActive(ptrTask) && minirtos_IsTaskDue(ptrTask, ptrCore->passTicks))
+        {
+            MINIRTOS_ENTER_CRITICAL();
+            minirtos_Ready_Push(ptrCore, ptrTask);
+            MINIRTOS_EXIT_CRITICAL();
+        }
+        ptrTask = ptrTask->gptrTaskNext;
+    } while (ptrTask != ptrCore->gptrTaskFirst);
+#endif
+}
+#endif
+
+#if (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+/*****************************************************************************
+ * @brief Lower the tick from which the task list has to be scanned again.
+ *
+ * @details Only ever lowered, so a task changed from an interrupt while the list
+ *   is being scanned is not lost.
+ *****************************************************************************/
+static void minirtos_Batch_Plan(Core_Descriptor_t *ptrCore, minirtos_Tick_t plannedTick)
+{
+    /* A task planned at or after the next scan is the common case, it needs no lock */
+    if ((minirtos_TickDiff_t)(plannedTick - ptrCore->batchTick) < ZERO)
+    {
+        MINIRTOS_ENTER_CRITICAL();
+        if ((minirtos_TickDiff_t)(plannedTick - ptrCore->batchTick) < ZERO)
+        {
+            ptrCore->batchTick = plannedTick;
+        }
+        MINIRTOS_EXIT_CRITICAL();
+    }
+}
+
+/*****************************************************************************
+ * @brief Link the tasks due at the current pass in a batch.
+ *
+ * @details Nothing happens before batchTick. Then one scan over the task list
+ *   links the due tasks in list order and plans the next scan at the earliest
+ *   task which is not due yet.
+ *****************************************************************************/
+static void minirtos_Batch_Build(Core_Descriptor_t *ptrCore)
+{
+    Task_Descriptor_t *ptrTask = ptrCore->gptrTaskFirst;
+    Task_Descriptor_t **ptrLink = &ptrCore->gptrBatchFirst;
+    minirtos_Tick_t nextTick = ptrCore->passTicks + MAX_TASK_INTERVAL;
+
+    if ((ptrTask == NULL) || ((minirtos_TickDiff_t)(ptrCore->batchTick - ptrCore->passTicks) > ZERO))
+    {
+        return;
+    }
+    ptrCore->batchTick = nextTick;
+    do
+    {
+        if (minirtos_IsTaskActive(ptrTask))
+        {
+            if (minirtos_IsTaskDue(ptrTask, ptrCore->passTicks))
+            {
+                *ptrLink = ptrTask;
+                ptrLink = &ptrTask->gptrBatchNext;
+            }
+            else if ((minirtos_TickDiff_t)(ptrTask->plannedTask - nextTick) < ZERO)
+            {
+                nextTick = ptrTask->plannedTask;
+            }
+        }
+        ptrTask = ptrTask->gptrTaskNext;
+    } while (ptrTask != ptrCore->gptrTaskFirst);
+    *ptrLink = NULL;
+    minirtos_Batch_Plan(ptrCore, nextTick);
+}
+#endif
+
+/*****************************************************************************
+ * @brief Propagate a change of task state to the scheduler.
+ *
+ * @details In timer list mode active tasks are (re)inserted at their plannedTask
+ *   and paused tasks are taken out. In priority mode the task leaves its ready
+ *   ring and is queued again if it is still due. In tickless mode a pending sleep is cancelled
+ *   so the new plannedTask is taken into account.
+ *
+ * @param ptrTask   Descriptor of the task which has been changed.
+ *****************************************************************************/
+static void minirtos_TaskChanged(Task_Descriptor_t *ptrTask)
+{
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+    glbTaskChanged = true;
+#endif
+#if (MINIRTOS_READY_LEVELS > 0)
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+
+    MINIRTOS_ENTER_CRITICAL();
+    minirtos_Ready_Remove(ptrCore, ptrTask);
+    if (minirtos_IsTaskActive(ptrTask) && minirtos_IsTaskDue(ptrTask, minirtos_GetTicks()))
+    {
+        /* Already due (e.g. RUN NOW), queue it right away */
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+        minirtos_Heap_Remove(ptrCore, ptrTask);
+#endif
+        minirtos_Ready_Push(ptrCore, ptrTask);
+    }
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+    else if (minirtos_IsTaskActive(ptrTask))
+    {
+        minirtos_Heap_Update(ptrCore, ptrTask);
+    }
+    else
+    {
+        minirtos_Heap_Remove(ptrCore, ptrTask);
+    }
+#endif
+    MINIRTOS_EXIT_CRITICAL();
+#elif (MINIRTOS_CFG_TIMER_LIST == 1)
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (minirtos_IsTaskActive(ptrTask))
+    {
+        minirtos_Heap_Update(ptrCore, ptrTask);
+    }
+    else
+    {
+        minirtos_Heap_Remove(ptrCore, ptrTask);
+    }
+    MINIRTOS_EXIT_CRITICAL();
+#elif (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+    if (minirtos_IsTaskActive(ptrTask))
+    {
+        /* The task may be due before the next planned scan */
+        minirtos_Batch_Plan(MINIRTOS_CORE(), ptrTask->plannedTask);
+    }
+#else
+    (void)ptrTask;
+#endif
+}
+
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+/*****************************************************************************
+ * @brief Call the task body and record its statistics.
+ *
+ * @details Execution time is measured with the cycle counter around the call. A
+ *   deadline is missed when the run finishes later than the relative deadline (the
+ *   interval without EDF) after the planned start.
+ *****************************************************************************/
+static void minirtos_Stats_Run(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask, minirtos_Tick_t releaseTick)
+{
+    Task_Stats_t *ptrStats = &ptrTask->taskStats;
+    uint32_t latency = (uint32_t)(ptrCore->passTicks - releaseTick);
+    uint32_t startCycles;
+    uint32_t cycles;
+#if (MINIRTOS_CFG_EDF == 1)
+    uint32_t deadline = ptrTask->taskDeadline;
+#else
+    uint32_t deadline = ptrTask->taskInterval;
+#endif
+
+    /* call the task */
+    startCycles = MINIRTOS_STATS_CYCLES();
+    minirtos_CallTask(ptrTask);
+    cycles = MINIRTOS_STATS_CYCLES() - startCycles;
+
+    MINIRTOS_ENTER_CRITICAL();
+    if ((ptrStats->runCount == 0) || (cycles < ptrStats->minCycles))
+    {
+        ptrStats->minCycles = cycles;
+    }
+    if (cycles > ptrStats->maxCycles)
+    {
+        ptrStats->maxCycles = cycles;
+    }
+    ptrStats->runCount++;
+    ptrStats->lastCycles = cycles;
+    ptrStats->totalCycles += cycles;
+    ptrStats->lastLatency = latency;
+    if (latency > ptrStats->maxLatency)
+    {
+        ptrStats->maxLatency = latency;
+    }
+    if ((deadline != 0) && ((uint32_t)(minirtos_GetTicks() - releaseTick) > deadline))
+    {
+        ptrStats->missedDeadlines++;
+    }
+    MINIRTOS_EXIT_CRITICAL();
+}
+#endif
+
+#if (MINIRTOS_CFG_DRIFT_FREE == 1)
+/*****************************************************************************
+ * @brief Plan the next run of a periodic task from its previous planned start.
+ *
+ * @details The next start is plannedTask + taskInterval, so the task keeps its
+ *   rate whatever the dispatch latency. When that start is already over a period
+ *   was missed and MINIRTOS_CFG_OVERRUN_POLICY decides what to do.
+ *
+ * @param ptrCore   Scheduler instance of the calling core.
+ *
+ * @param ptrTask   Descriptor of the task to plan.
+ *****************************************************************************/
+static void minirtos_PlanNextRun(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    minirtos_Tick_t sysTicks = ptrCore->passTicks;
+    minirtos_Tick_t nextTask = ptrTask->plannedTask + ptrTask->taskInterval;
+
+    if ((ptrTask->taskInterval == 0) || ((minirtos_TickDiff_t)(nextTask - sysTicks) > ZERO))
+    {
+        /* On time */
+        ptrTask->plannedTask = (ptrTask->taskInterval == 0) ? sysTicks : nextTask;
+#if (MINIRTOS_CFG_OVERRUN_POLICY == MINIRTOS_OVERRUN_CATCH_UP)
+        ptrTask->catchUpCount = 0;
+#endif
+        return;
+    }
+
+#if (MINIRTOS_CFG_OVERRUN_POLICY == MINIRTOS_OVERRUN_CATCH_UP)
+    if (ptrTask->catchUpCount < MINIRTOS_CFG_CATCH_UP_MAX)
+    {
+        /* Run the missed period right away */
+        ptrTask->catchUpCount++;
+        ptrTask->plannedTask = nextTask;
+        return;
+    }
+    ptrTask->catchUpCount = 0;
+#endif
+#if (MINIRTOS_CFG_OVERRUN_POLICY == MINIRTOS_OVERRUN_RESYNC)
+    /* New phase, one interval from now */
+    ptrTask->plannedTask = sysTicks + ptrTask->taskInterval;
+#else
+    /* Drop the missed periods, the next start stays on the original phase */
+    ptrTask->plannedTask = nextTask + ((sysTicks - nextTask) / ptrTask->taskInterval + 1) * ptrTask->taskInterval;
+#endif
+}
+#endif
+
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+/*****************************************************************************
+ * @brief Start the budget watch of a task about to run.
+ *****************************************************************************/
+static void minirtos_Budget_Start(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    MINIRTOS_ENTER_CRITICAL();
+    ptrCore->runStart = minirtos_GetTicks();
+    ptrCore->budgetExceeded = false;
+    ptrCore->gptrTaskRunning = ptrTask;
+    MINIRTOS_EXIT_CRITICAL();
+}
+
+/*****************************************************************************
+ * @brief Check in a task whose run completed within budget.
+ *
+ * @details Watched tasks check in once per round, the round is complete and the
+ *   watchdog is kicked when all of them did.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_Budget_CheckIn(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    if (ptrTask->checkInRound == ptrCore->checkInRound)
+    {
+        return;
+    }
+    ptrTask->checkInRound = ptrCore->checkInRound;
+    ptrCore->checkedIn++;
+    if (ptrCore->checkedIn >= ptrCore->watchedTasks)
+    {
+        /* Every watched task proved it is alive, start a new round */
+        ptrCore->checkInRound++;
+        ptrCore->checkedIn = 0;
+        if (gptrWatchdogHook != NULL)
+        {
+            gptrWatchdogHook();
+        }
+    }
+}
+
+/*****************************************************************************
+ * @brief End the budget watch of a task which returned.
+ *****************************************************************************/
+static void minirtos_Budget_End(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+    MINIRTOS_ENTER_CRITICAL();
+    ptrCore->gptrTaskRunning = NULL;
+    if ((ptrTask->taskBudget != 0) && (ptrCore->budgetExceeded == false))
+    {
+        minirtos_Budget_CheckIn(ptrCore, ptrTask);
+    }
+    MINIRTOS_EXIT_CRITICAL();
+}
+#endif
+
+/*****************************************************************************
+ * @brief Execute a due task.
+ *
+ * @details One shot tasks are paused, periodic tasks get their next start
+ *   planned before the task body is called, so the task itself may safely
+ *   pause, modify or remove its own descriptor.
+ *
+ * @param ptrCore   Scheduler instance of the calling core.
+ *
+ * @param ptrTask   Descriptor of the task to execute.
+ *****************************************************************************/
+static void minirtos_RunTask(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTask)
+{
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+    minirtos_Tick_t releaseTick = ptrTask->plannedTask;
+#endif
+
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    /* Hand the pending events to this run, later ones will start it again */
+    MINIRTOS_ENTER_CRITICAL();
+    ptrTask->runEvents = ptrTask->taskEvents;
+    ptrTask->taskEvents = 0;
+#endif
+    if ((ptrTask->taskStatus == TASK_ONE_SHOT) || (ptrTask->taskStatus == TASK_ONE_SHOT_NOW))
+    {
+        /* pause the task */
+        ptrTask->taskStatus = TASK_PAUSE;
+    }
+    else if (ptrTask->taskStatus != TASK_EVENT)
+    {
+        /* let's schedule next start */
+#if (MINIRTOS_CFG_DRIFT_FREE == 1)
+        minirtos_PlanNextRun(ptrCore, ptrTask);
+#else
+        ptrTask->plannedTask = ptrCore->passTicks + ptrTask->taskInterval;
+#endif
+    }
+    minirtos_TaskChanged(ptrTask);
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    MINIRTOS_EXIT_CRITICAL();
+#endif
+
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    minirtos_Budget_Start(ptrCore, ptrTask);
+#endif
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+    minirtos_Stats_Run(ptrCore, ptrTask, releaseTick);
+#else
+    /* call the task */
+    minirtos_CallTask(ptrTask);
+#endif
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    minirtos_Budget_End(ptrCore, ptrTask);
+#endif
+}
+
+#if (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+/*****************************************************************************
+ * @brief Run the tasks of the batch back to back.
+ *
+ * @details A task paused, removed or planned later by a task which ran before it
+ *   in the batch is skipped. All the tasks are planned from the same pass tick.
+ *****************************************************************************/
+static void minirtos_Batch_Run(Core_Descriptor_t *ptrCore)
+{
+    while (ptrCore->gptrBatchFirst != NULL)
+    {
+        Task_Descriptor_t *ptrTask = ptrCore->gptrBatchFirst;
+
+        ptrCore->gptrBatchFirst = ptrTask->gptrBatchNext;
+        ptrCore->gptrTaskSchedule = ptrTask;
+        if ((ptrTask->gptrTaskPrev != NULL) && minirtos_IsTaskActive(ptrTask) &&
+            minirtos_IsTaskDue(ptrTask, ptrCore->passTicks))
+        {
+            minirtos_RunTask(ptrCore, ptrTask);
+        }
+    }
+}
+#endif
+
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+/*****************************************************************************
+ * @brief Get the number of ticks until the earliest planned task.
+ *
+ * @details With software timers the sleep also ends at the nearest occupied
+ *   wheel slot, which may hold a timer of a later turn only. Pending deferred
+ *   calls prevent the sleep.
+ *
+ * @return 0 if a task is already due, UINT32_MAX if no task is active
+ *****************************************************************************/
+static uint32_t minirtos_GetIdleTicks(void)
+{
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+    uint32_t idleTicks = UINT32_MAX;
+    minirtos_Tick_t sysTicks = minirtos_GetTicks();
+
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE > 0)
+    if (ptrCore->deferHead != ptrCore->deferTail)
+    {
+        return 0;
+    }
+#endif
+#if (MINIRTOS_CFG_SW_TIMERS == 1)
+    /* The timers are serviced by the scheduler pass of the current tick */
+    if (ptrCore->timerTick != sysTicks)
+    {
+        return 0;
+    }
+    for (uint32_t slot = 1; slot <= MINIRTOS_CFG_TIMER_WHEEL_SIZE; slot++)
+    {
+        if (ptrCore->gptrTimerWheel[((uint32_t)sysTicks + slot) & (MINIRTOS_CFG_TIMER_WHEEL_SIZE - 1)] != NULL)
+        {
+            idleTicks = slot;
+            break;
+        }
+    }
+#endif
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+    if (ptrCore->heapCount != 0)
+    {
+        minirtos_TickDiff_t remaining = (minirtos_TickDiff_t)(ptrCore->gptrTaskHeap[0]->plannedTask - sysTicks);
+
+        if (remaining <= ZERO)
+        {
+            return 0;
+        }
+        if ((minirtos_Tick_t)remaining < idleTicks)
+        {
+            idleTicks = (uint32_t)remaining;
+        }
+    }
+#elif (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+    /* No active task is planned before batchTick */
+    if (ptrCore->gptrTaskFirst != NULL)
+    {
+        minirtos_TickDiff_t remaining = (minirtos_TickDiff_t)(ptrCore->batchTick - sysTicks);
+
+        if (remaining <= ZERO)
+        {
+            return 0;
+        }
+        if ((minirtos_Tick_t)remaining < idleTicks)
+        {
+            idleTicks = (uint32_t)remaining;
+        }
+    }
+#else
+    Task_Descriptor_t *ptrTask = ptrCore->gptrTaskFirst;
+
+    if (ptrTask == NULL)
+    {
+        return idleTicks;
+    }
+    do
+    {
+        if (minirtos_IsTaskActive(ptrTask))
+        {
+            minirtos_TickDiff_t remaining = (minirtos_TickDiff_t)(ptrTask->plannedTask - sysTicks);
+
+            if (remaining <= ZERO)
+            {
+                return 0;
+            }
+            if ((minirtos_Tick_t)remaining < idleTicks)
+            {
+                idleTicks = (uint32_t)remaining;
+            }
+        }
+        ptrTask = ptrTask->gptrTaskNext;
+    } while (ptrTask != ptrCore->gptrTaskFirst);
+#endif
+
+    return idleTicks;
+}
+
+/*****************************************************************************
+ * @brief Idle processing of the scheduler.
+ *
+ * @details Calls the idle hook, then sleeps until the earliest planned task
+ *   and adds the suppressed ticks to glbSysTicks. The sleep is skipped if a
+ *   task has been changed (e.g. from an interrupt) in the meantime.
+ *****************************************************************************/
+static void minirtos_Idle(void)
+{
+    uint32_t idleTicks;
+
+    glbTaskChanged = false;
+
+    if (gptrIdleHook != NULL)
+    {
+        gptrIdleHook();
+    }
+
+    idleTicks = minirtos_GetIdleTicks();
+    if (idleTicks == 0)
+    {
+        return;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (glbTaskChanged == false)
+    {
+        if ((idleTicks >= MINIRTOS_CFG_TICKLESS_MIN_TICKS) && (gptrSleepHook != NULL))
+        {
+            glbSysTicks += gptrSleepHook(idleTicks);
+        }
+        else
+        {
+            /* Too short to suppress the tick, wait for the next interrupt */
+            __DSB();
+            __WFI();
+            __ISB();
+        }
+    }
+    MINIRTOS_EXIT_CRITICAL();
+}
+#endif
+
+#if (MINIRTOS_CFG_HRTIMER == 1)
+/*****************************************************************************
+ * @brief Insert a timer task in the due list, sorted by plannedTask.
+ *
+ * @details Timer tasks with the same due time keep their insertion order.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_HrTimer_Insert(HrTask_Descriptor_t *ptrHrTask)
+{
+    HrTask_Descriptor_t **ptrLink = &gptrHrTaskFirst;
+
+    /* Signed difference, so the order stays right when the counter wraps */
+    while ((*ptrLink != NULL) && ((int32_t)((*ptrLink)->plannedTask - ptrHrTask->plannedTask) <= ZERO))
+    {
+        ptrLink = &(*ptrLink)->gptrTaskNext;
+    }
+    ptrHrTask->gptrTaskNext = *ptrLink;
+    *ptrLink = ptrHrTask;
+}
+
+/*****************************************************************************
+ * @brief Program the compare register with the earliest due time.
+ *
+ * @return False if that time is already over, the due tasks have to be run.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static bool minirtos_HrTimer_Program(void)
+{
+    if (gptrHrTaskFirst == NULL)
+    {
+        return true;
+    }
+    MINIRTOS_HRTIMER_CCR = gptrHrTaskFirst->plannedTask;
+
+    /* The counter might have passed the compare value while it was written */
+    return ((int32_t)(gptrHrTaskFirst->plannedTask - MINIRTOS_HRTIMER_CNT) > ZERO);
+}
+#endif
+
+#if (MINIRTOS_CFG_SW_TIMERS == 1)
+/*****************************************************************************
+ * @brief Insert a timer at the head of the wheel slot of its expiry tick.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_Timer_Link(Core_Descriptor_t *ptrCore, Timer_Descriptor_t *ptrTimer)
+{
+    Timer_Descriptor_t **ptrSlot = &ptrCore->gptrTimerWheel[(uint32_t)ptrTimer->expiryTick & (MINIRTOS_CFG_TIMER_WHEEL_SIZE - 1)];
+
+    ptrTimer->gptrTimerNext = *ptrSlot;
+    if (*ptrSlot != NULL)
+    {
+        (*ptrSlot)->gptrTimerLink = &ptrTimer->gptrTimerNext;
+    }
+    *ptrSlot = ptrTimer;
+    ptrTimer->gptrTimerLink = ptrSlot;
+}
+
+/*****************************************************************************
+ * @brief Take a timer out of its list.
+ *
+ * @details The link back to the slot head or to the previous timer makes it O(1).
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_Timer_Unlink(Timer_Descriptor_t *ptrTimer)
+{
+    *ptrTimer->gptrTimerLink = ptrTimer->gptrTimerNext;
+    if (ptrTimer->gptrTimerNext != NULL)
+    {
+        ptrTimer->gptrTimerNext->gptrTimerLink = ptrTimer->gptrTimerLink;
+    }
+    ptrTimer->gptrTimerNext = NULL;
+    ptrTimer->gptrTimerLink = NULL;
+}
+
+/*****************************************************************************
+ * @brief Take the next expired timer of a serviced slot.
+ *
+ * @details Timers of a later turn of the wheel go back to their slot. An expired
+ *   periodic timer is linked again at its next expiry, on the original phase unless
+ *   whole periods were missed.
+ *
+ * @param ptrPending   Timers of the slot not looked at yet.
+ *
+ * @return Timer whose callback has to be called, NULL once the slot is done
+ *****************************************************************************/
+static Timer_Descriptor_t *minirtos_Timer_Take(Core_Descriptor_t *ptrCore, Timer_Descriptor_t **ptrPending,
+                                               minirtos_Tick_t sysTicks)
+{
+    Timer_Descriptor_t *ptrTimer;
+
+    MINIRTOS_ENTER_CRITICAL();
+    while ((ptrTimer = *ptrPending) != NULL)
+    {
+        minirtos_Timer_Unlink(ptrTimer);
+        if ((minirtos_TickDiff_t)(ptrTimer->expiryTick - sysTicks) > ZERO)
+        {
+            minirtos_Timer_Link(ptrCore, ptrTimer);
+            continue;
+        }
+        if (ptrTimer->timerPeriod != 0)
+        {
+            ptrTimer->expiryTick += ptrTimer->timerPeriod;
+            if ((minirtos_TickDiff_t)(ptrTimer->expiryTick - sysTicks) <= ZERO)
+            {
+                ptrTimer->expiryTick = sysTicks + ptrTimer->timerPeriod;
+            }
+            minirtos_Timer_Link(ptrCore, ptrTimer);
+        }
+        break;
+    }
+    MINIRTOS_EXIT_CRITICAL();
+
+    return ptrTimer;
+}
+
+/*****************************************************************************
+ * @brief Fire the timers which expired since the last scheduler pass.
+ *
+ * @details The slot of every tick since the last service is visited, all of them
+ *   once if the wheel has been skipped over (e.g. by a long task). A slot is first
+ *   moved to a local list, so the callbacks may start, restart or stop any timer,
+ *   themselves included.
+ *
+ * @param ptrCore   Scheduler instance of the calling core.
+ *****************************************************************************/
+static void minirtos_Timer_Service(Core_Descriptor_t *ptrCore)
+{
+    minirtos_Tick_t sysTicks = ptrCore->passTicks;
+    minirtos_Tick_t elapsed = sysTicks - ptrCore->timerTick;
+
+    if (elapsed == 0)
+    {
+        return;
+    }
+    if (elapsed > MINIRTOS_CFG_TIMER_WHEEL_SIZE)
+    {
+        elapsed = MINIRTOS_CFG_TIMER_WHEEL_SIZE;
+    }
+    ptrCore->timerTick = sysTicks;
+
+    for (minirtos_Tick_t tick = sysTicks - elapsed + 1; elapsed > 0; tick++, elapsed--)
+    {
+        Timer_Descriptor_t *ptrPending;
+        Timer_Descriptor_t *ptrTimer;
+
+        {
+            MINIRTOS_ENTER_CRITICAL();
+            ptrPending = ptrCore->gptrTimerWheel[(uint32_t)tick & (MINIRTOS_CFG_TIMER_WHEEL_SIZE - 1)];
+            ptrCore->gptrTimerWheel[(uint32_t)tick & (MINIRTOS_CFG_TIMER_WHEEL_SIZE - 1)] = NULL;
+            if (ptrPending != NULL)
+            {
+                ptrPending->gptrTimerLink = &ptrPending;
+            }
+            MINIRTOS_EXIT_CRITICAL();
+        }
+        while ((ptrTimer = minirtos_Timer_Take(ptrCore, &ptrPending, sysTicks)) != NULL)
+        {
+            ptrTimer->timerCallback(ptrTimer);
+        }
+    }
+}
+#endif
+
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE > 0)
+/*****************************************************************************
+ * @brief Claim the next slot of the deferred call ring.
+ *
+ * @details Lock-free with the exclusive accesses of Cortex-M3 and above, a handler
+ *   interrupting the claim makes the store fail and the claim is tried again.
+ *   Without them the counter is advanced in a critical section of a few instructions.
+ *
+ * @param ptrSlot   Claimed position of the ring.
+ *
+ * @return False if the ring is full
+ *****************************************************************************/
+static bool minirtos_Defer_Claim(Core_Descriptor_t *ptrCore, uint32_t *ptrSlot)
+{
+#if defined(__ARM_FEATURE_LDREX) && ((__ARM_FEATURE_LDREX & 4) != 0)
+    uint32_t tail;
+
+    do
+    {
+        tail = __LDREXW(&ptrCore->deferTail);
+        if ((tail - ptrCore->deferHead) >= MINIRTOS_CFG_DEFER_QUEUE_SIZE)
+        {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(tail + 1U, &ptrCore->deferTail) != 0U);
+
+    *ptrSlot = tail;
+    return true;
+#else
+    bool claimed = false;
+
+    MINIRTOS_ENTER_CRITICAL();
+    if ((ptrCore->deferTail - ptrCore->deferHead) < MINIRTOS_CFG_DEFER_QUEUE_SIZE)
+    {
+        *ptrSlot = ptrCore->deferTail++;
+        claimed = true;
+    }
+    MINIRTOS_EXIT_CRITICAL();
+
+    return claimed;
+#endif
+}
+
+/*****************************************************************************
+ * @brief Make the calls deferred before the current scheduler pass.
+ *
+ * @details The calls run in posting order with interrupts enabled. Calls posted
+ *   meanwhile, also by the deferred functions themselves, wait for the next pass
+ *   so the tasks cannot be starved.
+ *
+ * @param ptrCore   Scheduler instance of the calling core.
+ *****************************************************************************/
+static void minirtos_Defer_Service(Core_Descriptor_t *ptrCore)
+{
+    uint32_t head = ptrCore->deferHead;
+    uint32_t tail = ptrCore->deferTail;
+
+    while (head != tail)
+    {
+        Defer_Call_t *ptrCall = &ptrCore->deferCalls[head & (MINIRTOS_CFG_DEFER_QUEUE_SIZE - 1)];
+        gptr_Defer_Function ptrFunction = ptrCall->deferFunction;
+        void *ptrArgument;
+
+        if (ptrFunction == NULL)
+        {
+            /* Claimed by a context which did not write it yet, next pass */
+            break;
+        }
+        /* Read the argument only after the function which published it */
+        __DMB();
+        ptrArgument = ptrCall->ptrArgument;
+        ptrCall->deferFunction = NULL;
+
+        /* The slot has to be free before a handler can claim it again */
+        __DMB();
+        ptrCore->deferHead = ++head;
+        ptrFunction(ptrArgument);
+    }
+}
+#endif
+
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+/*****************************************************************************
+ * @brief Request a context switch if the running context is not the right one.
+ *
+ * @details The highest ready thread has to run, the cooperative context when no
+ *   thread is ready. PendSV is the lowest exception, so the switch happens once
+ *   all the interrupts returned and the critical section is left.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_Thread_Reschedule(void)
+{
+    Thread_Descriptor_t *ptrThread = NULL;
+
+    if (glbThreadReady != 0)
+    {
+        ptrThread = gptrThreadTable[MINIRTOS_CLZ(glbThreadReady)];
+    }
+    if (ptrThread != gptrThreadCurrent)
+    {
+        MINIRTOS_SCB_ICSR = MINIRTOS_ICSR_PENDSVSET;
+        __DSB();
+        __ISB();
+    }
+}
+
+/*****************************************************************************
+ * @brief Block the running thread.
+ *
+ * @details A thread going to wait keeps running if a notification is already there.
+ *   The switch is taken when the critical section is left.
+ *****************************************************************************/
+static void minirtos_Thread_Block(Thread_Descriptor_t *ptrThread, Thread_Status_e threadStatus, minirtos_Tick_t wakeTick)
+{
+    uint32_t threadBit = (0x80000000UL >> ptrThread->threadPriority);
+
+    MINIRTOS_ENTER_CRITICAL();
+    if ((threadStatus != THREAD_WAITING) || (ptrThread->threadNotify == 0))
+    {
+        ptrThread->threadStatus = threadStatus;
+        ptrThread->wakeTick = wakeTick;
+        glbThreadReady &= ~threadBit;
+        if (threadStatus == THREAD_DELAYED)
+        {
+            glbThreadDelayed |= threadBit;
+        }
+        minirtos_Thread_Reschedule();
+    }
+    MINIRTOS_EXIT_CRITICAL();
+}
+
+/*****************************************************************************
+ * @brief Called when a thread function returns, the thread becomes dormant.
+ *****************************************************************************/
+static void minirtos_Thread_Exit(void)
+{
+    Thread_Descriptor_t *ptrThread = gptrThreadCurrent;
+
+    MINIRTOS_ENTER_CRITICAL();
+    glbThreadReady &= ~(0x80000000UL >> ptrThread->threadPriority);
+    gptrThreadTable[ptrThread->threadPriority] = NULL;
+    ptrThread->threadStatus = THREAD_DORMANT;
+    minirtos_Thread_Reschedule();
+    MINIRTOS_EXIT_CRITICAL();
+
+    /* Never resumed */
+    while (1)
+    {
+    }
+}
+
+/*****************************************************************************
+ * @brief Save the stack pointer of the running context and elect the next one.
+ *
+ * @details Called by PendSV_Handler() with the stack pointer of the context it just
+ *   saved, returns the stack pointer of the context to restore.
+ *****************************************************************************/
+static uint32_t * __attribute__((used)) minirtos_Thread_Switch(uint32_t *ptrStack)
+{
+    if (gptrThreadCurrent == NULL)
+    {
+        gptrMainStack = ptrStack;
+    }
+    else
+    {
+        gptrThreadCurrent->stackPointer = ptrStack;
+    }
+
+    gptrThreadCurrent = (glbThreadReady != 0) ? gptrThreadTable[MINIRTOS_CLZ(glbThreadReady)] : NULL;
+
+    return (gptrThreadCurrent == NULL) ? gptrMainStack : gptrThreadCurrent->stackPointer;
+}
+#endif
+
+/*****************************************************************************
+ * @brief Get the byte offset of a queue slot in the buffer.
+ *
+ * @details A shift replaces the multiply when the element size is a power of two.
+ *****************************************************************************/
+static uint32_t minirtos_Queue_Offset(const Queue_Descriptor_t *ptrq, uint16_t slot)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_POW2_ELEMENT)
+    {
+        return ((uint32_t)slot << ptrq->elementShift);
+    }
+    return ((uint32_t)slot * ptrq->elementSize);
+}
+
+/*****************************************************************************
+ * @brief Advance a head or tail index to the next slot.
+ *
+ * @details Masked when the capacity is a power of two, otherwise wrapped with a
+ *   compare, no division is needed in either case.
+ *****************************************************************************/
+static uint16_t minirtos_Queue_Advance(const Queue_Descriptor_t *ptrq, uint16_t index)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_POW2_SIZE)
+    {
+        return (uint16_t)((index + 1) & (ptrq->maxElements - 1));
+    }
+    index++;
+    return (index == ptrq->maxElements) ? 0 : index;
+}
+
+/*****************************************************************************
+ * @brief Number of elements in a lock-free queue.
+ *
+ * @details head and tail run over twice the queue size, so a full and an empty
+ *   queue can be told apart without a shared count field.
+ *****************************************************************************/
+static uint16_t minirtos_Queue_Used(const Queue_Descriptor_t *ptrq, uint16_t head, uint16_t tail)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_POW2_SIZE)
+    {
+        return (uint16_t)((tail - head) & ((2 * (uint32_t)ptrq->maxElements) - 1));
+    }
+    return (tail >= head) ? (uint16_t)(tail - head) : (uint16_t)(tail + (2 * (uint32_t)ptrq->maxElements) - head);
+}
+
+/*****************************************************************************
+ * @brief Advance a lock-free queue index, wrapping at twice the queue size.
+ *****************************************************************************/
+static uint16_t minirtos_Queue_Next(const Queue_Descriptor_t *ptrq, uint16_t index)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_POW2_SIZE)
+    {
+        return (uint16_t)((index + 1) & ((2 * (uint32_t)ptrq->maxElements) - 1));
+    }
+    index++;
+    return (index == (2 * (uint32_t)ptrq->maxElements)) ? 0 : index;
+}
+
+/*****************************************************************************
+ * @brief Get the buffer slot number of a lock-free queue index.
+ *****************************************************************************/
+static uint16_t minirtos_Queue_SlotIndex(const Queue_Descriptor_t *ptrq, uint16_t index)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_POW2_SIZE)
+    {
+        return (uint16_t)(index & (ptrq->maxElements - 1));
+    }
+    return (index >= ptrq->maxElements) ? (uint16_t)(index - ptrq->maxElements) : index;
+}
+
+/*****************************************************************************
+ * @brief Get the buffer slot of a lock-free queue index.
+ *****************************************************************************/
+static uint8_t *minirtos_Queue_Slot(const Queue_Descriptor_t *ptrq, uint16_t index)
+{
+    return &((uint8_t *)ptrq->buffer)[minirtos_Queue_Offset(ptrq, minirtos_Queue_SlotIndex(ptrq, index))];
+}
+
+/*****************************************************************************
+ * @brief Copy a block of elements into the buffer, starting at a slot.
+ *
+ * @details The block is split at the end of the buffer, so at most two memcpy
+ *   calls are needed.
+ *****************************************************************************/
+static void minirtos_Queue_CopyIn(Queue_Descriptor_t *ptrq, uint16_t slot, const uint8_t *ptrmsg, uint16_t number)
+{
+    uint8_t *ptrbuf = (uint8_t *)ptrq->buffer;
+    uint16_t first = ptrq->maxElements - slot;
+
+    if (first > number)
+    {
+        first = number;
+    }
+    memcpy(&ptrbuf[minirtos_Queue_Offset(ptrq, slot)], ptrmsg, minirtos_Queue_Offset(ptrq, first));
+    if (number > first)
+    {
+        memcpy(ptrbuf, &ptrmsg[minirtos_Queue_Offset(ptrq, first)], minirtos_Queue_Offset(ptrq, number - first));
+    }
+}
+
+/*****************************************************************************
+ * @brief Copy a block of elements out of the buffer, starting at a slot.
+ *****************************************************************************/
+static void minirtos_Queue_CopyOut(const Queue_Descriptor_t *ptrq, uint16_t slot, uint8_t *ptrmsg, uint16_t number)
+{
+    const uint8_t *ptrbuf = (const uint8_t *)ptrq->buffer;
+    uint16_t first = ptrq->maxElements - slot;
+
+    if (first > number)
+    {
+        first = number;
+    }
+    memcpy(ptrmsg, &ptrbuf[minirtos_Queue_Offset(ptrq, slot)], minirtos_Queue_Offset(ptrq, first));
+    if (number > first)
+    {
+        memcpy(&ptrmsg[minirtos_Queue_Offset(ptrq, first)], ptrbuf, minirtos_Queue_Offset(ptrq, number - first));
+    }
+}
+
+/*****************************************************************************
+ * @brief Move a head or tail index forward by a number of slots.
+ *
+ * @param range maxElements for a locked queue, 2 * maxElements for a lock-free one.
+ *****************************************************************************/
+static uint16_t minirtos_Queue_Forward(uint16_t index, uint16_t number, uint32_t range)
+{
+    uint32_t next = (uint32_t)index + number;
+
+    if (next >= range)
+    {
+        next -= range;
+    }
+    return (uint16_t)next;
+}
+
+/*****************************************************************************
+ * @brief Make room for number elements at the tail of a locked queue.
+ *
+ * @details An overwrite queue drops as many of its oldest elements as needed,
+ *   unless the oldest one is held by minirtos_Queue_Peek(). Any other queue
+ *   only takes what fits.
+ *
+ * @return number when all of them are accepted (an overwrite queue then stores only
+ *   the last maxElements), otherwise the free slots.
+ *****************************************************************************/
+static uint16_t minirtos_Queue_Room(Queue_Descriptor_t *ptrq, uint16_t number)
+{
+    uint16_t space = ptrq->maxElements - ptrq->count;
+    uint16_t drop;
+
+    if ((number <= space) ||
+        ((ptrq->flags & (MINIRTOS_QUEUE_FLAG_OVERWRITE | MINIRTOS_QUEUE_FLAG_PEEKED)) != MINIRTOS_QUEUE_FLAG_OVERWRITE))
+    {
+        return (number <= space) ? number : space;
+    }
+
+    drop = ((number < ptrq->maxElements) ? number : ptrq->maxElements) - space;
+    ptrq->head = minirtos_Queue_Forward(ptrq->head, drop, ptrq->maxElements);
+    ptrq->count -= drop;
+    return number;
+}
+
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
+/*****************************************************************************
+ * @brief Check whether a caller is blocked on one side of a queue.
+ *****************************************************************************/
+static bool minirtos_Queue_HasWaiter(const Queue_Descriptor_t *ptrq, bool sender)
+{
+    bool waiting = false;
+
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+    waiting |= ((sender ? ptrq->threadSendWait : ptrq->threadReceiveWait) != 0);
+#endif
+#if (MINIRTOS_CFG_COROUTINES == 1)
+    waiting |= ((sender ? ptrq->ptrTaskSendWait : ptrq->ptrTaskReceiveWait) != NULL);
+#endif
+    return waiting;
+}
+
+/*****************************************************************************
+ * @brief Wake the highest priority caller blocked on one side of a queue.
+ *
+ * @details A waiting thread comes first, it preempts the cooperative tasks anyway,
+ *   else the first parked coroutine task is made due at once. A thread whose
+ *   timeout already made it ready is skipped, it retries as soon as it runs.
+ *
+ * @param ptrq     Descriptor of the queue.
+ *
+ * @param sender   True to wake a sender (a slot was freed), false a receiver.
+ *****************************************************************************/
+static void minirtos_Queue_WakeWaiter(Queue_Descriptor_t *ptrq, bool sender)
+{
+    /* Callers park inside a critical section, seeing no waiter here is final */
+    if (!minirtos_Queue_HasWaiter(ptrq, sender))
+    {
+        return;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+    volatile uint32_t *ptrThreads = sender ? &ptrq->threadSendWait : &ptrq->threadReceiveWait;
+
+    while (*ptrThreads != 0)
+    {
+        uint8_t priority = (uint8_t)MINIRTOS_CLZ(*ptrThreads);
+        uint32_t threadBit = (0x80000000UL >> priority);
+        Thread_Descriptor_t *ptrThread = gptrThreadTable[priority];
+
+        *ptrThreads &= ~threadBit;
+        if ((ptrThread != NULL) &&
+            ((ptrThread->threadStatus == THREAD_PENDING) || (ptrThread->threadStatus == THREAD_DELAYED)))
+        {
+            ptrThread->threadStatus = THREAD_READY;
+            glbThreadDelayed &= ~threadBit;
+            glbThreadReady |= threadBit;
+            minirtos_Thread_Reschedule();
+            MINIRTOS_EXIT_CRITICAL();
+            return;
+        }
+    }
+#endif
+#if (MINIRTOS_CFG_COROUTINES == 1)
+    Task_Descriptor_t **ptrLink = sender ? &ptrq->ptrTaskSendWait : &ptrq->ptrTaskReceiveWait;
+
+    while (*ptrLink != NULL)
+    {
+        Task_Descriptor_t *ptrTask = *ptrLink;
+
+        *ptrLink = ptrTask->gptrWaitNext;
+        ptrTask->ptrWaitQueue = NULL;
+        if (minirtos_IsTaskActive(ptrTask))
+        {
+            /* Retries its call on the next scheduler pass */
+            ptrTask->plannedTask = minirtos_GetTicks();
+            minirtos_TaskChanged(ptrTask);
+            break;
+        }
+    }
+#endif
+    MINIRTOS_EXIT_CRITICAL();
+}
+
+/*****************************************************************************
+ * @brief Pass the wake on after a blocked call succeeded.
+ *
+ * @details A block transfer or a flush may have made room for more than the one
+ *   waiter it woke, each waiter which succeeds wakes the next one while the queue
+ *   still has an element (receivers) or a free slot (senders).
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_Queue_WakeNext(Queue_Descriptor_t *ptrq, bool sender)
+{
+    uint16_t count = minirtos_Queue_Count(ptrq);
+
+    if (sender ? (count < ptrq->maxElements) : (count != 0))
+    {
+        minirtos_Queue_WakeWaiter(ptrq, sender);
+    }
+}
+#endif
+
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_COROUTINES == 1)
+/*****************************************************************************
+ * @brief Unlink a coroutine task from the queue it is parked on.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_Co_Unpark(Task_Descriptor_t *ptrTask)
+{
+    Queue_Descriptor_t *ptrq = ptrTask->ptrWaitQueue;
+    Task_Descriptor_t **ptrLink;
+
+    if (ptrq == NULL)
+    {
+        return;
+    }
+    /* Parked either as a sender or as a receiver */
+    ptrLink = &ptrq->ptrTaskSendWait;
+    while ((*ptrLink != NULL) && (*ptrLink != ptrTask))
+    {
+        ptrLink = &(*ptrLink)->gptrWaitNext;
+    }
+    if (*ptrLink == NULL)
+    {
+        ptrLink = &ptrq->ptrTaskReceiveWait;
+        while ((*ptrLink != NULL) && (*ptrLink != ptrTask))
+        {
+            ptrLink = &(*ptrLink)->gptrWaitNext;
+        }
+    }
+    if (*ptrLink != NULL)
+    {
+        *ptrLink = ptrTask->gptrWaitNext;
+    }
+    ptrTask->ptrWaitQueue = NULL;
+}
+
+/*****************************************************************************
+ * @brief One attempt of a blocking coroutine send or receive.
+ *
+ * @details The call and the parking are done in the same critical section, so a
+ *   change of the queue in between can not be missed. A parked task is linked
+ *   behind the waiters of the same or a higher priority and planned at its
+ *   timeout, a wait longer than MAX_TASK_INTERVAL parks again when it expires.
+ *   On a lock-free queue the task is not parked and retries on every tick.
+ *
+ * @param ptrTask   Descriptor of the calling task.
+ *
+ * @param ptrq      Descriptor of the queue.
+ *
+ * @param ptrmsg    Element to send or memory for the received one.
+ *
+ * @param send      True for a send, false for a receive.
+ *
+ * @param timeout   Ticks from ptrTask->waitStart, MINIRTOS_WAIT_FOREVER for no limit.
+ *
+ * @return QUEUE_WAIT_DONE, QUEUE_WAIT_TIMEOUT or QUEUE_WAIT_PARKED
+ *****************************************************************************/
+static Queue_Wait_e minirtos_Co_Wait(Task_Descriptor_t *ptrTask, Queue_Descriptor_t *ptrq,
+                                     void *ptrmsg, bool send, uint32_t timeout)
+{
+    Queue_Wait_e result = QUEUE_WAIT_PARKED;
+    uint32_t elapsed;
+    bool done;
+
+    MINIRTOS_ENTER_CRITICAL();
+    minirtos_Co_Unpark(ptrTask);
+    done = send ? minirtos_Queue_Send(ptrq, ptrmsg) : minirtos_Queue_Receive(ptrq, ptrmsg);
+    elapsed = (uint32_t)(minirtos_GetTicks() - ptrTask->waitStart);
+    if (done)
+    {
+        minirtos_Queue_WakeNext(ptrq, send);
+        result = QUEUE_WAIT_DONE;
+    }
+    else if ((timeout != MINIRTOS_WAIT_FOREVER) && (elapsed >= timeout))
+    {
+        result = QUEUE_WAIT_TIMEOUT;
+    }
+    else
+    {
+        Task_Descriptor_t **ptrLink = send ? &ptrq->ptrTaskSendWait : &ptrq->ptrTaskReceiveWait;
+        uint32_t remaining = timeout - elapsed;
+
+        if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+        {
+            /* A lock-free queue wakes nobody, try again on the next tick */
+            remaining = 1;
+        }
+        else
+        {
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+            while ((*ptrLink != NULL) && ((*ptrLink)->taskPriority <= ptrTask->taskPriority))
+#else
+            while (*ptrLink != NULL)
+#endif
+            {
+                ptrLink = &(*ptrLink)->gptrWaitNext;
+            }
+            ptrTask->gptrWaitNext = *ptrLink;
+            *ptrLink = ptrTask;
+            ptrTask->ptrWaitQueue = ptrq;
+        }
+
+        ptrTask->plannedTask = minirtos_GetTicks() + ((remaining > MAX_TASK_INTERVAL) ? MAX_TASK_INTERVAL : remaining);
+        minirtos_TaskChanged(ptrTask);
+    }
+    MINIRTOS_EXIT_CRITICAL();
+
+    return result;
+}
+#endif
+
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_PREEMPTIVE == 1)
+/*****************************************************************************
+ * @brief Blocking send or receive of the running thread.
+ *
+ * @details Each attempt runs in a critical section which also blocks the thread
+ *   when the queue is full or empty, the switch is taken when it is left. A woken
+ *   thread tries again, it blocks once more if another context was faster. Nothing
+ *   wakes a waiter of a lock-free queue, the thread then retries on every tick.
+ *
+ * @param ptrq      Descriptor of the queue.
+ *
+ * @param ptrmsg    Element to send or memory for the received one.
+ *
+ * @param send      True for a send, false for a receive.
+ *
+ * @param timeout   Ticks to wait, MINIRTOS_WAIT_FOREVER for no limit.
+ *
+ * @return True or False (timeout)
+ *****************************************************************************/
+static bool minirtos_Queue_ThreadWait(Queue_Descriptor_t *ptrq, void *ptrmsg, bool send, uint32_t timeout)
+{
+    Thread_Descriptor_t *ptrThread = gptrThreadCurrent;
+    uint32_t threadBit = (0x80000000UL >> ptrThread->threadPriority);
+    volatile uint32_t *ptrWaiters = send ? &ptrq->threadSendWait : &ptrq->threadReceiveWait;
+    minirtos_Tick_t waitStart = minirtos_GetTicks();
+    bool done = false;
+    bool waiting = true;
+
+    while (waiting)
+    {
+        MINIRTOS_ENTER_CRITICAL();
+        *ptrWaiters &= ~threadBit;
+        done = send ? minirtos_Queue_Send(ptrq, ptrmsg) : minirtos_Queue_Receive(ptrq, ptrmsg);
+        if (done)
+        {
+            minirtos_Queue_WakeNext(ptrq, send);
+            waiting = false;
+        }
+        else if ((timeout != MINIRTOS_WAIT_FOREVER) && ((uint32_t)(minirtos_GetTicks() - waitStart) >= timeout))
+        {
+            waiting = false;
+        }
+        else if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+        {
+            /* A lock-free queue wakes nobody, try again on the next tick */
+            minirtos_Thread_Block(ptrThread, THREAD_DELAYED, minirtos_GetTicks() + 1);
+        }
+        else if (timeout == MINIRTOS_WAIT_FOREVER)
+        {
+            *ptrWaiters |= threadBit;
+            minirtos_Thread_Block(ptrThread, THREAD_PENDING, 0);
+        }
+        else
+        {
+            *ptrWaiters |= threadBit;
+            minirtos_Thread_Block(ptrThread, THREAD_DELAYED, waitStart + timeout);
+        }
+        MINIRTOS_EXIT_CRITICAL();
+    }
+
+    return done;
+}
+#endif
+
+/*****************************************************************************
+ * @brief Notify the task bound to a queue after a successful send.
+ *
+ * @details Also wakes the highest priority receiver blocked on the queue.
+ *****************************************************************************/
+static void minirtos_Queue_Wake(Queue_Descriptor_t *ptrq)
+{
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    if (ptrq->ptrTaskWake != NULL)
+    {
+        (void)minirtos_NotifyTask(ptrq->ptrTaskWake, ptrq->wakeEvents);
+    }
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
+    minirtos_Queue_WakeWaiter(ptrq, false);
+#endif
+    (void)ptrq;
+}
+
+/*****************************************************************************
+ * @brief Wake the highest priority sender blocked on a queue after slots were freed.
+ *****************************************************************************/
+static void minirtos_Queue_Freed(Queue_Descriptor_t *ptrq)
+{
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
+    minirtos_Queue_WakeWaiter(ptrq, true);
+#else
+    (void)ptrq;
+#endif
+}
+
+/*****************************************************************************
+ * @brief Enqueue data into a single producer / single consumer queue.
+ *
+ * @details Only the producer writes tail and only the consumer writes head, the
+ *   barrier publishes the element before the new tail, interrupts stay enabled.
+ *****************************************************************************/
+static bool minirtos_Queue_SendSPSC(Queue_Descriptor_t *ptrq, const void *ptrmsg)
+{
+    uint16_t tail = ptrq->tail;
+    uint16_t head = *(volatile uint16_t *)&ptrq->head;
+
+    if (minirtos_Queue_Used(ptrq, head, tail) == ptrq->maxElements)
+    {
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_FULL, ptrq);
+        return false; // Queue is full
+    }
+
+    memcpy(minirtos_Queue_Slot(ptrq, tail), ptrmsg, ptrq->elementSize);
+
+    /* The element has to be written before the consumer can see the new tail */
+    __DMB();
+    *(volatile uint16_t *)&ptrq->tail = minirtos_Queue_Next(ptrq, tail);
+    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_SEND, ptrq);
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Dequeue data from a single producer / single consumer queue.
+ *****************************************************************************/
+static bool minirtos_Queue_ReceiveSPSC(Queue_Descriptor_t *ptrq, void *ptrmsg)
+{
+    uint16_t head = ptrq->head;
+    uint16_t tail = *(volatile uint16_t *)&ptrq->tail;
+
+    if (head == tail)
+    {
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_EMPTY, ptrq);
+        return false; // Queue is empty
+    }
+
+    /* Read the element only after the tail which published it */
+    __DMB();
+    memcpy(ptrmsg, minirtos_Queue_Slot(ptrq, head), ptrq->elementSize);
+
+    /* The element has to be read before the producer can reuse the slot */
+    __DMB();
+    *(volatile uint16_t *)&ptrq->head = minirtos_Queue_Next(ptrq, head);
+    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_RECEIVE, ptrq);
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Create/init a queue instance.
+ *
+ * @details Creates a new queue for application/user.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param buffer User allocated queue space for operation
+ *
+ * @param elementSize Size of each element in the queue.
+ *
+ * @param maxElementrs Maximum elements allowed in particular queue, put a power of two
+ *                     (and a power of two elementSize) for the fastest indexing.
+ *
+ * @return True or False
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_Create(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements)
+{
+    if (!ptrq || !buffer || elementSize == 0 || maxElements == 0)
+    	{
+    		return false;
+    	}
+
+    ptrq->buffer = buffer;
+    ptrq->elementSize = elementSize;
+    ptrq->maxElements = maxElements;
+    ptrq->head = 0;
+    ptrq->tail = 0;
+    ptrq->count = 0;
+    ptrq->flags = 0;
+    ptrq->elementShift = 0;
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    ptrq->ptrTaskWake = NULL;
+    ptrq->wakeEvents = 0;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_PREEMPTIVE == 1)
+    ptrq->threadSendWait = 0;
+    ptrq->threadReceiveWait = 0;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_COROUTINES == 1)
+    ptrq->ptrTaskSendWait = NULL;
+    ptrq->ptrTaskReceiveWait = NULL;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+    ptrq->sequence = 0;
+#endif
+
+    /* Power of two sizes let send/receive use a mask and a shift */
+    if ((maxElements & (maxElements - 1)) == 0)
+    {
+    	ptrq->flags |= MINIRTOS_QUEUE_FLAG_POW2_SIZE;
+    }
+    if ((elementSize & (elementSize - 1)) == 0)
+    {
+    	ptrq->flags |= MINIRTOS_QUEUE_FLAG_POW2_ELEMENT;
+    	while ((1U << ptrq->elementShift) != elementSize)
+    	{
+    		ptrq->elementShift++;
+    	}
+    }
+
+    return true;
+}
+/*****************************************************************************
+ * @brief Create/init a lock-free single producer / single consumer queue.
+ *
+ * @details Same as minirtos_Queue_Create(), but minirtos_Queue_Send() and
+ *   minirtos_Queue_Receive() never disable interrupts on this queue. Only head
+ *   and tail are shared, each one written by a single side, and memory barriers
+ *   order the element copy against the index update.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param buffer User allocated queue space for operation
+ *
+ * @param elementSize Size of each element in the queue.
+ *
+ * @param maxElementrs Maximum elements allowed in particular queue, up to
+ *                     MAX_NO_OF_SPSC_QUEUE_ELEMENTS.
+ *
+ * @return True or False
+ *
+ * @warning Exactly one producer (e.g. an ISR) and one consumer (e.g. a task) may
+ *          use the queue. minirtos_Queue_Flush() must be called by the consumer.
+ *          To stay lock-free the queue can not be bound to a task and wakes no
+ *          blocked caller, a blocking call on it retries on every tick.
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_CreateSPSC(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements)
+{
+    /* head and tail run up to twice the queue size */
+    if ((maxElements > MAX_NO_OF_SPSC_QUEUE_ELEMENTS) || !minirtos_Queue_Create(ptrq, buffer, elementSize, maxElements))
+    {
+        return false;
+    }
+    ptrq->flags |= MINIRTOS_QUEUE_FLAG_SPSC;
+
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Create/init a queue which overwrites its oldest element when full.
+ *
+ * @details Same as minirtos_Queue_Create(), but a send on a full queue drops the
+ *   oldest element, so the consumer always finds the latest maxElements and never
+ *   has to drain stale data first. minirtos_Queue_SendBlock() with more than
+ *   maxElements keeps the last ones of the block. A send still fails while a
+ *   slot is reserved, or while the oldest element is held by minirtos_Queue_Peek().
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param buffer User allocated queue space for operation
+ *
+ * @param elementSize Size of each element in the queue.
+ *
+ * @param maxElementrs Number of latest elements kept.
+ *
+ * @return True or False
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_CreateOverwrite(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements)
+{
+    if (!minirtos_Queue_Create(ptrq, buffer, elementSize, maxElements))
+    {
+        return false;
+    }
+    ptrq->flags |= MINIRTOS_QUEUE_FLAG_OVERWRITE;
+
+    return true;
+}
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+/*****************************************************************************
+ * @brief Bind a task to a queue.
+ *
+ * @details After each successful send (single, block or commit) the task gets
+ *   taskEvents notified, a consumer task no longer has to poll the queue.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param ptrTaskDescriptor   Task to wake, NULL to unbind.
+ *
+ * @param taskEvents   Events given to the task, must not be 0.
+ *
+ * @return True or False (false as well for a lock-free queue, the consumer of an
+ *         SPSC queue is notified by its producer with minirtos_NotifyTask())
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_BindTask(Queue_Descriptor_t *ptrq, Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskEvents)
+{
+    if ((ptrq == NULL) || ((ptrTaskDescriptor != NULL) && (taskEvents == 0)) ||
+        (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC))
+    {
+        return false; // Notifying would mask the interrupts of a lock-free queue
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    ptrq->ptrTaskWake = ptrTaskDescriptor;
+    ptrq->wakeEvents = taskEvents;
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    return true;
+}
+#endif
+
+/*****************************************************************************
+ * @brief Enqueue data into queue.
+ *
+ * @details Copies an item (of size specified at queue creation) into the queue.
+ *   This function can be safely called from both main code and interrupt context, as it enters a critical
+ *   section (disables interrupts) to protect the internal data structure. Operation is quick and minimal for ISR safety.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param ptrmsg User message in the given queue.
+ *
+ * @return True or False
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_Send(Queue_Descriptor_t *ptrq, const void *ptrmsg)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        return minirtos_Queue_SendSPSC(ptrq, ptrmsg);
+    }
+
+	MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if ((ptrq->flags & MINIRTOS_QUEUE_FLAG_RESERVED) || (minirtos_Queue_Room(ptrq, 1) == 0))
+    	{
+    	    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    	    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_FULL, ptrq);
+    		return false; // Queue is full
+    	}
+
+    uint8_t *ptrbuf = (uint8_t *)ptrq->buffer;
+    uint32_t idx = minirtos_Queue_Offset(ptrq, ptrq->tail);    // Calculate where to write
+
+    memcpy(&ptrbuf[idx], ptrmsg, ptrq->elementSize);       // Copy in the data
+
+    ptrq->tail = minirtos_Queue_Advance(ptrq, ptrq->tail);     // Increment/cycle tail
+    ptrq->count++;                                // Increment item count
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+    ptrq->sequence++;
+#endif
+    minirtos_Queue_Wake(ptrq);
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_SEND, ptrq);
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Dequeue data from queue.
+ *
+ * @details  Copies an item out of the queue into user memory. Can be safely called from both
+ *   main code and interrupt context, as it disables interrupts during the operation to prevent data races.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param ptrmsg User message removed from queue.
+ *
+ * @return True or False
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_Receive(Queue_Descriptor_t *ptrq, void *ptrmsg)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        return minirtos_Queue_ReceiveSPSC(ptrq, ptrmsg);
+    }
+
+	MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if ((ptrq->count == 0) || (ptrq->flags & (MINIRTOS_QUEUE_FLAG_PEEKED | MINIRTOS_QUEUE_FLAG_BROADCAST)))
+    	{
+    		MINIRTOS_QUEUE_EXIT_CRITICAL();
+    		MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_EMPTY, ptrq);
+    		return false;           // Queue is empty
+    	}
+
+    uint8_t *ptrbuf = (uint8_t *)ptrq->buffer;
+    uint32_t idx = minirtos_Queue_Offset(ptrq, ptrq->head);    // Where to read
+
+    memcpy(ptrmsg, &ptrbuf[idx], ptrq->elementSize);       // Copy out the data
+
+    ptrq->head = minirtos_Queue_Advance(ptrq, ptrq->head);     // Move head forward
+    ptrq->count--;                                // Decrement item count
+    minirtos_Queue_Freed(ptrq);
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_RECEIVE, ptrq);
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Enqueue a block of elements into queue.
+ *
+ * @details Copies up to number elements with one critical section and at most two
+ *   memcpy calls (the block is split where the buffer wraps). Elements which do not
+ *   fit are left out, the caller gets back how many were queued. Same context rules
+ *   as minirtos_Queue_Send().
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param ptrmsg First of the consecutive user elements.
+ *
+ * @param number Number of elements in ptrmsg.
+ *
+ * @return Number of elements queued.
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+uint16_t minirtos_Queue_SendBlock(Queue_Descriptor_t *ptrq, const void *ptrmsg, uint16_t number)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        uint16_t tail = ptrq->tail;
+        uint16_t head = *(volatile uint16_t *)&ptrq->head;
+        uint16_t space = ptrq->maxElements - minirtos_Queue_Used(ptrq, head, tail);
+
+        if (number > space)
+        {
+            number = space;
+        }
+        if (number != 0)
+        {
+            minirtos_Queue_CopyIn(ptrq, minirtos_Queue_SlotIndex(ptrq, tail), (const uint8_t *)ptrmsg, number);
+
+            /* The elements have to be written before the consumer can see the new tail */
+            __DMB();
+            *(volatile uint16_t *)&ptrq->tail = minirtos_Queue_Forward(tail, number, 2 * (uint32_t)ptrq->maxElements);
+            MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_SEND, ptrq);
+        }
+        else
+        {
+            MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_FULL, ptrq);
+        }
+        return number;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_RESERVED)
+    {
+        number = 0;
+    }
+    else
+    {
+        number = minirtos_Queue_Room(ptrq, number);
+    }
+    if (number != 0)
+    {
+        /* An overwrite queue only stores the last maxElements of a larger block */
+        uint16_t skip = (number > ptrq->maxElements) ? (uint16_t)(number - ptrq->maxElements) : 0;
+
+        minirtos_Queue_CopyIn(ptrq, ptrq->tail, &((const uint8_t *)ptrmsg)[minirtos_Queue_Offset(ptrq, skip)], number - skip);
+        ptrq->tail = minirtos_Queue_Forward(ptrq->tail, number - skip, ptrq->maxElements);
+        ptrq->count += number - skip;
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+        ptrq->sequence += number;
+#endif
+        minirtos_Queue_Wake(ptrq);
+    }
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    if (number != 0)
+    {
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_SEND, ptrq);
+    }
+    else
+    {
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_FULL, ptrq);
+    }
+    return number;
+}
+
+/*****************************************************************************
+ * @brief Dequeue a block of elements from queue.
+ *
+ * @details Copies up to number elements out with one critical section and at most
+ *   two memcpy calls. Same context rules as minirtos_Queue_Receive().
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param ptrmsg User memory for up to number elements.
+ *
+ * @param number Maximum number of elements to remove.
+ *
+ * @return Number of elements removed.
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+uint16_t minirtos_Queue_ReceiveBlock(Queue_Descriptor_t *ptrq, void *ptrmsg, uint16_t number)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        uint16_t head = ptrq->head;
+        uint16_t tail = *(volatile uint16_t *)&ptrq->tail;
+        uint16_t used = minirtos_Queue_Used(ptrq, head, tail);
+
+        if (number > used)
+        {
+            number = used;
+        }
+        if (number != 0)
+        {
+            /* Read the elements only after the tail which published them */
+            __DMB();
+            minirtos_Queue_CopyOut(ptrq, minirtos_Queue_SlotIndex(ptrq, head), (uint8_t *)ptrmsg, number);
+
+            /* The elements have to be read before the producer can reuse the slots */
+            __DMB();
+            *(volatile uint16_t *)&ptrq->head = minirtos_Queue_Forward(head, number, 2 * (uint32_t)ptrq->maxElements);
+            MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_RECEIVE, ptrq);
+        }
+        else
+        {
+            MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_EMPTY, ptrq);
+        }
+        return number;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if (ptrq->flags & (MINIRTOS_QUEUE_FLAG_PEEKED | MINIRTOS_QUEUE_FLAG_BROADCAST))
+    {
+        number = 0;
+    }
+    else if (number > ptrq->count)
+    {
+        number = ptrq->count;
+    }
+    if (number != 0)
+    {
+        minirtos_Queue_CopyOut(ptrq, ptrq->head, (uint8_t *)ptrmsg, number);
+        ptrq->head = minirtos_Queue_Forward(ptrq->head, number, ptrq->maxElements);
+        ptrq->count -= number;
+        minirtos_Queue_Freed(ptrq);
+    }
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    if (number != 0)
+    {
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_RECEIVE, ptrq);
+    }
+    else
+    {
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_EMPTY, ptrq);
+    }
+    return number;
+}
+
+/*****************************************************************************
+ * @brief Reserve the next free slot of a queue for a zero-copy send.
+ *
+ * @details The producer builds the element directly in the queue buffer and then
+ *   publishes it with minirtos_Queue_Commit(). On a locked queue the slot stays
+ *   reserved in between, other senders fail until the commit. On a lock-free queue
+ *   only the single producer may reserve a slot anyway.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @return Pointer to elementSize bytes of the queue buffer, NULL when the queue is
+ *   full or a slot is already reserved.
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+void *minirtos_Queue_Reserve(Queue_Descriptor_t *ptrq)
+{
+    uint8_t *ptrslot = NULL;
+
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        uint16_t tail = ptrq->tail;
+
+        if (minirtos_Queue_Used(ptrq, *(volatile uint16_t *)&ptrq->head, tail) != ptrq->maxElements)
+        {
+            ptrslot = minirtos_Queue_Slot(ptrq, tail);
+        }
+        return ptrslot;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if (!(ptrq->flags & MINIRTOS_QUEUE_FLAG_RESERVED) && (minirtos_Queue_Room(ptrq, 1) != 0))
+    {
+        ptrq->flags |= MINIRTOS_QUEUE_FLAG_RESERVED;
+        ptrslot = &((uint8_t *)ptrq->buffer)[minirtos_Queue_Offset(ptrq, ptrq->tail)];
+    }
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    return ptrslot;
+}
+
+/*****************************************************************************
+ * @brief Publish the slot returned by minirtos_Queue_Reserve().
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @return True or False (nothing reserved on a locked queue, full lock-free queue)
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_Commit(Queue_Descriptor_t *ptrq)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        uint16_t tail = ptrq->tail;
+
+        if (minirtos_Queue_Used(ptrq, *(volatile uint16_t *)&ptrq->head, tail) == ptrq->maxElements)
+        {
+            /* No slot can have been reserved on a full queue */
+            MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_FULL, ptrq);
+            return false;
+        }
+        /* The element has to be written before the consumer can see the new tail */
+        __DMB();
+        *(volatile uint16_t *)&ptrq->tail = minirtos_Queue_Next(ptrq, tail);
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_SEND, ptrq);
+        return true;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if (!(ptrq->flags & MINIRTOS_QUEUE_FLAG_RESERVED))
+    {
+        MINIRTOS_QUEUE_EXIT_CRITICAL();
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_FULL, ptrq);
+        return false;
+    }
+    ptrq->flags &= (uint8_t)~MINIRTOS_QUEUE_FLAG_RESERVED;
+    ptrq->tail = minirtos_Queue_Advance(ptrq, ptrq->tail);
+    ptrq->count++;
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+    ptrq->sequence++;
+#endif
+    minirtos_Queue_Wake(ptrq);
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_SEND, ptrq);
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Get the oldest element of a queue for a zero-copy receive.
+ *
+ * @details The consumer parses the element in place, it stays queued until
+ *   minirtos_Queue_Release(). On a locked queue other receivers fail in between.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @return Pointer to the element in the queue buffer, NULL when the queue is empty
+ *   or the element is already held.
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+const void *minirtos_Queue_Peek(Queue_Descriptor_t *ptrq)
+{
+    const uint8_t *ptrslot = NULL;
+
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        uint16_t head = ptrq->head;
+
+        if (head != *(volatile uint16_t *)&ptrq->tail)
+        {
+            /* Read the element only after the tail which published it */
+            __DMB();
+            ptrslot = minirtos_Queue_Slot(ptrq, head);
+        }
+        return ptrslot;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if ((ptrq->count != 0) && !(ptrq->flags & (MINIRTOS_QUEUE_FLAG_PEEKED | MINIRTOS_QUEUE_FLAG_BROADCAST)))
+    {
+        ptrq->flags |= MINIRTOS_QUEUE_FLAG_PEEKED;
+        ptrslot = &((const uint8_t *)ptrq->buffer)[minirtos_Queue_Offset(ptrq, ptrq->head)];
+    }
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    return ptrslot;
+}
+
+/*****************************************************************************
+ * @brief Free the slot returned by minirtos_Queue_Peek().
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @return True or False (nothing held on a locked queue, empty lock-free queue)
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_Release(Queue_Descriptor_t *ptrq)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        uint16_t head = ptrq->head;
+
+        if (head == *(volatile uint16_t *)&ptrq->tail)
+        {
+            /* Nothing to release on an empty queue */
+            MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_EMPTY, ptrq);
+            return false;
+        }
+        /* The element has to be read before the producer can reuse the slot */
+        __DMB();
+        *(volatile uint16_t *)&ptrq->head = minirtos_Queue_Next(ptrq, head);
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_RECEIVE, ptrq);
+        return true;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if (!(ptrq->flags & MINIRTOS_QUEUE_FLAG_PEEKED))
+    {
+        MINIRTOS_QUEUE_EXIT_CRITICAL();
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_EMPTY, ptrq);
+        return false;
+    }
+    ptrq->flags &= (uint8_t)~MINIRTOS_QUEUE_FLAG_PEEKED;
+    ptrq->head = minirtos_Queue_Advance(ptrq, ptrq->head);
+    ptrq->count--;
+    minirtos_Queue_Freed(ptrq);
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_RECEIVE, ptrq);
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Get number of items currently in queue.
+ *
+ * @details No of elements available in the queue.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @retval no of elements present at the movement.
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+uint16_t minirtos_Queue_Count(Queue_Descriptor_t *ptrq)
+{
+    if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+    {
+        return minirtos_Queue_Used(ptrq, *(volatile uint16_t *)&ptrq->head, *(volatile uint16_t *)&ptrq->tail);
+    }
+    return ptrq->count;
+}
+
+/*****************************************************************************
+ * @brief Flush (clear) all contents from the queue.
+ *
+ * @details Resets head, tail, and count so queue is empty.
+ *   Protects structure with critical section for safe use from main/IRQ context.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @return
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+void minirtos_Queue_Flush(Queue_Descriptor_t *ptrq)
+{
+	if (ptrq->flags & MINIRTOS_QUEUE_FLAG_SPSC)
+	{
+		/* Consumer side, drop everything published so far */
+		*(volatile uint16_t *)&ptrq->head = *(volatile uint16_t *)&ptrq->tail;
+		return;
+	}
+
+	MINIRTOS_QUEUE_ENTER_CRITICAL();
+	ptrq->head = 0;
+	ptrq->tail = 0;
+	ptrq->count = 0;
+	ptrq->flags &= (uint8_t)~(MINIRTOS_QUEUE_FLAG_RESERVED | MINIRTOS_QUEUE_FLAG_PEEKED);
+	minirtos_Queue_Freed(ptrq);
+	MINIRTOS_QUEUE_EXIT_CRITICAL();
+}
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_PREEMPTIVE == 1)
+/*****************************************************************************
+ * @brief Enqueue data, waiting for a free slot.
+ *
+ * @details A thread finding the queue full is blocked until a receive frees a
+ *   slot or timeout ticks elapsed, lower priority threads and the cooperative
+ *   tasks run meanwhile. Out of a thread (cooperative task, interrupt) the call
+ *   does not wait and is minirtos_Queue_Send().
+ *
+ * @param ptrq    Descriptor of the queue.
+ *
+ * @param ptrmsg  User message in the given queue.
+ *
+ * @param timeout Ticks to wait, 0 does not wait, MINIRTOS_WAIT_FOREVER never gives up.
+ *
+ * @return True or False (timeout)
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_SendWait(Queue_Descriptor_t *ptrq, const void *ptrmsg, uint32_t timeout)
+{
+    if ((gptrThreadCurrent == NULL) || (__get_IPSR() != 0) || (timeout == 0))
+    {
+        return minirtos_Queue_Send(ptrq, ptrmsg);
+    }
+
+    return minirtos_Queue_ThreadWait(ptrq, (void *)ptrmsg, true, timeout);
+}
+
+/*****************************************************************************
+ * @brief Dequeue data, waiting for an element.
+ *
+ * @details Same rules as minirtos_Queue_SendWait(), the thread is woken by a send.
+ *
+ * @param ptrq    Descriptor of the queue.
+ *
+ * @param ptrmsg  User message removed from queue.
+ *
+ * @param timeout Ticks to wait, 0 does not wait, MINIRTOS_WAIT_FOREVER never gives up.
+ *
+ * @return True or False (timeout)
+ *
+ * @see @Queue_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Queue_ReceiveWait(Queue_Descriptor_t *ptrq, void *ptrmsg, uint32_t timeout)
+{
+    if ((gptrThreadCurrent == NULL) || (__get_IPSR() != 0) || (timeout == 0))
+    {
+        return minirtos_Queue_Receive(ptrq, ptrmsg);
+    }
+
+    return minirtos_Queue_ThreadWait(ptrq, ptrmsg, false, timeout);
+}
+#endif
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+/*****************************************************************************
+ * @brief Create/init a broadcast queue.
+ *
+ * @details The queue is sent to like any locked queue (single, block or zero-copy)
+ *   and overwrites its oldest element when full, so a slow consumer never holds
+ *   up the producer. Every consumer reads it through its own Queue_Reader_t, one
+ *   buffer serves all of them. minirtos_Queue_Receive(), minirtos_Queue_ReceiveBlock()
+ *   and minirtos_Queue_Peek() fail on it and a thread waiting in
+ *   minirtos_Queue_ReceiveWait() never gets an element, a reader task is woken
+ *   with minirtos_Queue_BindTask() instead.
+ *
+ * @param ptrq   Descriptor of the queue.
+ *
+ * @param buffer User allocated queue space for operation
+ *
+ * @param elementSize Size of each element in the queue.
+ *
+ * @param maxElementrs Number of latest elements kept for the readers.
+ *
+ * @return True or False
+ *
+ * @see @Queue_Reader_t
+ *****************************************************************************/
+bool minirtos_Queue_CreateBroadcast(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements)
+{
+    if (!minirtos_Queue_Create(ptrq, buffer, elementSize, maxElements))
+    {
+        return false;
+    }
+    ptrq->flags |= MINIRTOS_QUEUE_FLAG_OVERWRITE | MINIRTOS_QUEUE_FLAG_BROADCAST;
+
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Attach a reader to a broadcast queue.
+ *
+ * @details The reader starts after the last element sent so far. Readers can be
+ *   attached and dropped at any time, the queue keeps no list of them.
+ *
+ * @param ptrReader Cursor of the consumer.
+ *
+ * @param ptrq      Broadcast queue.
+ *
+ * @return True or False (not a broadcast queue)
+ *
+ * @see @Queue_Reader_t
+ *****************************************************************************/
+bool minirtos_Queue_ReaderAttach(Queue_Reader_t *ptrReader, Queue_Descriptor_t *ptrq)
+{
+    if ((ptrReader == NULL) || (ptrq == NULL) || !(ptrq->flags & MINIRTOS_QUEUE_FLAG_BROADCAST))
+    {
+        return false;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    ptrReader->ptrq = ptrq;
+    ptrReader->sequence = ptrq->sequence;
+    ptrReader->lost = 0;
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Copy the next element of a broadcast queue for one reader.
+ *
+ * @details The element stays queued for the other readers. Its slot follows from
+ *   how far the reader is behind the sender (count - pending slots after head), so
+ *   no index is kept per reader. A reader more than count elements behind was
+ *   overtaken: the overwritten elements are added to its lost count and it
+ *   continues with the oldest element still queued.
+ *
+ * @param ptrReader Cursor of the consumer.
+ *
+ * @param ptrmsg    User memory for one element.
+ *
+ * @return True or False (nothing new for this reader)
+ *
+ * @see @Queue_Reader_t
+ *****************************************************************************/
+bool minirtos_Queue_ReaderReceive(Queue_Reader_t *ptrReader, void *ptrmsg)
+{
+    Queue_Descriptor_t *ptrq = ptrReader->ptrq;
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    uint32_t pending = ptrq->sequence - ptrReader->sequence;
+
+    if (pending > ptrq->count)
+    {
+        ptrReader->lost += pending - ptrq->count;
+        pending = ptrq->count;
+    }
+    if (pending == 0)
+    {
+        ptrReader->sequence = ptrq->sequence;
+        MINIRTOS_QUEUE_EXIT_CRITICAL();
+        MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_EMPTY, ptrq);
+        return false;
+    }
+
+    uint16_t slot = minirtos_Queue_Forward(ptrq->head, (uint16_t)(ptrq->count - pending), ptrq->maxElements);
+
+    memcpy(ptrmsg, &((const uint8_t *)ptrq->buffer)[minirtos_Queue_Offset(ptrq, slot)], ptrq->elementSize);
+    ptrReader->sequence = ptrq->sequence - pending + 1;
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    MINIRTOS_TRACE(MINIRTOS_TRACE_QUEUE_RECEIVE, ptrq);
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Get the number of elements a reader has not read yet.
+ *
+ * @param ptrReader Cursor of the consumer.
+ *
+ * @return Elements still queued for this reader, at most maxElements.
+ *
+ * @see @Queue_Reader_t
+ *****************************************************************************/
+uint16_t minirtos_Queue_ReaderCount(Queue_Reader_t *ptrReader)
+{
+    Queue_Descriptor_t *ptrq = ptrReader->ptrq;
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    uint32_t pending = ptrq->sequence - ptrReader->sequence;
+
+    if (pending > ptrq->count)
+    {
+        pending = ptrq->count;
+    }
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    return (uint16_t)pending;
+}
+
+/*****************************************************************************
+ * @brief Get the number of elements overwritten before the reader got them.
+ *
+ * @param ptrReader Cursor of the consumer.
+ *
+ * @return Lost elements since minirtos_Queue_ReaderAttach().
+ *
+ * @see @Queue_Reader_t
+ *****************************************************************************/
+uint32_t minirtos_Queue_ReaderLost(const Queue_Reader_t *ptrReader)
+{
+    return ptrReader->lost;
+}
+#endif
+#if (MINIRTOS_CFG_BLOCK_POOL == 1)
+/*****************************************************************************
+ * @brief Create/init a block pool instance.
+ *
+ * @details Cuts the user storage in numberOfBlocks blocks and links them all in
+ *   the free list, in address order.
+ *
+ * @param ptrPool   Descriptor of the pool.
+ *
+ * @param buffer    User allocated pool space, numberOfBlocks * MINIRTOS_POOL_BLOCK_SIZE(blockSize)
+ *                  bytes aligned for a pointer.
+ *
+ * @param blockSize Size of each block, rounded up with MINIRTOS_POOL_BLOCK_SIZE().
+ *
+ * @param numberOfBlocks Number of blocks of the pool.
+ *
+ * @return True or False
+ *
+ * @see @Pool_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Pool_Create(Pool_Descriptor_t *ptrPool, void *buffer, uint16_t blockSize, uint16_t numberOfBlocks)
+{
+    uint32_t size = MINIRTOS_POOL_BLOCK_SIZE((uint32_t)blockSize);
+    uint8_t *ptrBlock = (uint8_t *)buffer;
+
+    if ((ptrPool == NULL) || (buffer == NULL) || (blockSize == 0) || (size > UINT16_MAX) ||
+        (numberOfBlocks == 0) || (((uintptr_t)buffer % sizeof(void *)) != 0))
+    {
+        return false;
+    }
+
+    ptrPool->buffer = ptrBlock;
+    ptrPool->blockSize = (uint16_t)size;
+    ptrPool->numberOfBlocks = numberOfBlocks;
+    ptrPool->freeBlocks = numberOfBlocks;
+    ptrPool->peakBlocks = 0;
+    ptrPool->ptrFree = ptrBlock;
+    for (uint16_t index = 1; index < numberOfBlocks; index++)
+    {
+        *(void **)ptrBlock = ptrBlock + size;
+        ptrBlock += size;
+    }
+    *(void **)ptrBlock = NULL;
+
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Take a block from a pool.
+ *
+ * @details O(1): the first block of the free list is unlinked in a critical
+ *   section, so the pool can be shared by tasks and interrupts.
+ *
+ * @param ptrPool   Descriptor of the pool.
+ *
+ * @return Pointer to blockSize bytes, NULL when all the blocks are in use.
+ *
+ * @see @Pool_Descriptor_t
+ *****************************************************************************/
+void *minirtos_Pool_Alloc(Pool_Descriptor_t *ptrPool)
+{
+    void *ptrBlock;
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    ptrBlock = ptrPool->ptrFree;
+    if (ptrBlock != NULL)
+    {
+        ptrPool->ptrFree = *(void **)ptrBlock;
+        ptrPool->freeBlocks--;
+        if ((uint16_t)(ptrPool->numberOfBlocks - ptrPool->freeBlocks) > ptrPool->peakBlocks)
+        {
+            ptrPool->peakBlocks = ptrPool->numberOfBlocks - ptrPool->freeBlocks;
+        }
+    }
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    return ptrBlock;
+}
+
+/*****************************************************************************
+ * @brief Give a block back to its pool.
+ *
+ * @details O(1), the block is pushed on the free list and is the next one handed
+ *   out. A pointer out of the pool storage or not at the start of a block, and a
+ *   free beyond the number of blocks, are refused. So is a block which is already
+ *   the head of the free list (freed twice in a row). Any other double free would
+ *   turn the free list into a cycle and is only detected with
+ *   MINIRTOS_CFG_POOL_CHECK, which walks the free list.
+ *
+ * @param ptrPool   Descriptor of the pool.
+ *
+ * @param ptrBlock  Block returned by minirtos_Pool_Alloc().
+ *
+ * @return True or False
+ *
+ * @see @Pool_Descriptor_t
+ *****************************************************************************/
+bool minirtos_Pool_Free(Pool_Descriptor_t *ptrPool, void *ptrBlock)
+{
+    uintptr_t offset = (uintptr_t)ptrBlock - (uintptr_t)ptrPool->buffer;
+
+    if ((ptrBlock == NULL) || (offset >= ((uintptr_t)ptrPool->blockSize * ptrPool->numberOfBlocks)) ||
+        ((offset % ptrPool->blockSize) != 0))
+    {
+        return false;
+    }
+
+    MINIRTOS_QUEUE_ENTER_CRITICAL();
+    if ((ptrPool->freeBlocks == ptrPool->numberOfBlocks) || (ptrBlock == ptrPool->ptrFree))
+    {
+        MINIRTOS_QUEUE_EXIT_CRITICAL();
+        return false; // Every block or this block is already free
+    }
+#if (MINIRTOS_CFG_POOL_CHECK == 1)
+    for (void *ptrFree = ptrPool->ptrFree; ptrFree != NULL; ptrFree = *(void **)ptrFree)
+    {
+        if (ptrFree == ptrBlock)
+        {
+            MINIRTOS_QUEUE_EXIT_CRITICAL();
+            return false; // Double free
+        }
+    }
+#endif
+    *(void **)ptrBlock = ptrPool->ptrFree;
+    ptrPool->ptrFree = ptrBlock;
+    ptrPool->freeBlocks++;
+    MINIRTOS_QUEUE_EXIT_CRITICAL();
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Get the number of free blocks of a pool.
+ *
+ * @param ptrPool   Descriptor of the pool.
+ *
+ * @return Number of blocks minirtos_Pool_Alloc() can still hand out.
+ *
+ * @see @Pool_Descriptor_t
+ *****************************************************************************/
+uint16_t minirtos_Pool_FreeCount(Pool_Descriptor_t *ptrPool)
+{
+    return ptrPool->freeBlocks;
+}
+
+/*****************************************************************************
+ * @brief Get the high-water mark of a pool.
+ *
+ * @param ptrPool   Descriptor of the pool.
+ *
+ * @return Highest number of blocks in use at the same time since the pool was created.
+ *
+ * @see @Pool_Descriptor_t
+ *****************************************************************************/
+uint16_t minirtos_Pool_GetPeak(Pool_Descriptor_t *ptrPool)
+{
+    return ptrPool->peakBlocks;
+}
+#endif
+/*****************************************************************************
+ * @brief Get a consistent snapshot of the system tick.
+ *
+ * @details A 64 bit tick is read with two loads on a 32 bit core, the tick is
+ *   read again until both reads agree so the value is never torn by the tick
+ *   interrupt. A 32 bit tick is a single load.
+ *
+ * @return Current value of glbSysTicks
+ *****************************************************************************/
+minirtos_Tick_t minirtos_GetTicks(void)
+{
+#if (MINIRTOS_CFG_TICK_64BIT == 1)
+	minirtos_Tick_t sysTicks;
+
+	do
+	{
+		sysTicks = glbSysTicks;
+	} while (sysTicks != glbSysTicks);
+
+	return sysTicks;
+#else
+	return glbSysTicks;
+#endif
+}
+
+/*****************************************************************************
+ * @brief Entry function for the user to initiate scheduler.
+ *
+ * @details This function as to be called before doing anything with the tasker. It
+ * initiates the tasker subsystems. If this funtion is not called before doing
+ * anything with the tasker all functions will return false.
+ *
+ * @param   None
+ *
+ * @return  None
+ *
+ * @retval  None
+ *
+ * @note Should be called once from `main()` or before scheduler to start application.
+ *****************************************************************************/
+void minirtos_Init(void)
+{
+	glbInitialized = true;
+	glbSysTicks = 0;
+	/* Empty task lists, timer lists and ready rings on every core */
+	memset(glbCore, 0, sizeof(glbCore));
+#if (MINIRTOS_CFG_CORES > 1)
+	for (uint8_t core = 0; core < MINIRTOS_CFG_CORES; core++)
+	{
+		for (uint8_t sender = 0; sender < MINIRTOS_CFG_CORES; sender++)
+		{
+			(void)minirtos_Queue_CreateSPSC(&glbCore[core].coreMailbox[sender], glbCore[core].coreMessages[sender],
+			                                sizeof(Core_Message_t), MINIRTOS_CFG_CORE_MAILBOX);
+		}
+	}
+#endif
+#if (MINIRTOS_CFG_HRTIMER == 1)
+	gptrHrTaskFirst = NULL;
+#endif
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+	memset(gptrThreadTable, 0, sizeof(gptrThreadTable));
+	gptrThreadCurrent = NULL;
+	glbThreadReady = 0;
+	glbThreadDelayed = 0;
+#endif
+#if ((MINIRTOS_CFG_TASK_STATS == 1) || (MINIRTOS_CFG_TRACE_SIZE > 0)) && !defined(MINIRTOS_STATS_NO_DWT)
+	/* Start the cycle counter used to time the tasks */
+	MINIRTOS_DEMCR |= MINIRTOS_DEMCR_TRCENA;
+	MINIRTOS_DWT_CYCCNT = 0;
+	MINIRTOS_DWT_CTRL |= MINIRTOS_DWT_CYCCNTENA;
+#endif
+#if (MINIRTOS_CFG_TASK_POOL_SIZE > 0)
+	/* Chain all the descriptors of the pool in the free list */
+	gptrTaskPoolFree = NULL;
+	for (uint16_t index = MINIRTOS_CFG_TASK_POOL_SIZE; index > 0; index--)
+	{
+		/* A free descriptor links back at itself, it can neither be added nor released */
+		glbTaskPool[index - 1].taskStatus = TASK_NOT_FOUND;
+		glbTaskPool[index - 1].gptrTaskNext = gptrTaskPoolFree;
+		glbTaskPool[index - 1].gptrTaskPrev = &glbTaskPool[index - 1];
+		gptrTaskPoolFree = &glbTaskPool[index - 1];
+	}
+#endif
+}
+#if (MINIRTOS_CFG_TASK_POOL_SIZE > 0)
+/*****************************************************************************
+ * @brief Take a task descriptor from the static pool.
+ *
+ * @details O(1), can be called from main code and interrupt context. The
+ *   descriptor is then handed to minirtos_AddTask() like a user allocated one.
+ *
+ * @param   None
+ *
+ * @return Pointer to a free descriptor, NULL if the pool is empty or the
+ *         scheduler is not initialized.
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+Task_Descriptor_t *minirtos_TaskPool_Acquire(void)
+{
+	Task_Descriptor_t *ptrTask;
+
+	if (glbInitialized == false)
+	{
+		return NULL;
+	}
+
+	MINIRTOS_ENTER_CRITICAL();
+	MINIRTOS_CORE_LOCK();
+	ptrTask = gptrTaskPoolFree;
+	if (ptrTask != NULL)
+	{
+		gptrTaskPoolFree = ptrTask->gptrTaskNext;
+		ptrTask->gptrTaskNext = NULL;
+		ptrTask->gptrTaskPrev = NULL;
+		ptrTask->taskStatus = TASK_PAUSE;
+	}
+	MINIRTOS_CORE_UNLOCK();
+	MINIRTOS_EXIT_CRITICAL();
+
+	return ptrTask;
+}
+/*****************************************************************************
+ * @brief Give a task descriptor back to the static pool.
+ *
+ * @details O(1), can be called from main code and interrupt context.
+ *
+ * @param ptrTaskDescriptor   Descriptor obtained from minirtos_TaskPool_Acquire().
+ *
+ * @return False if the descriptor does not belong to the pool, is already free
+ *         or is still in the scheduler (see minirtos_RemoveTask()).
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_TaskPool_Release(Task_Descriptor_t *ptrTaskDescriptor)
+{
+	if ((glbInitialized == false) ||
+		(ptrTaskDescriptor < &glbTaskPool[0]) ||
+		(ptrTaskDescriptor > &glbTaskPool[MINIRTOS_CFG_TASK_POOL_SIZE - 1]))
+	{
+		return false;
+	}
+
+	MINIRTOS_ENTER_CRITICAL();
+	MINIRTOS_CORE_LOCK();
+	if (ptrTaskDescriptor->gptrTaskPrev != NULL)
+	{
+		MINIRTOS_CORE_UNLOCK();
+		MINIRTOS_EXIT_CRITICAL();
+		return false; // Already in the pool or still in the scheduler
+	}
+	ptrTaskDescriptor->taskStatus = TASK_NOT_FOUND;
+	ptrTaskDescriptor->gptrTaskPrev = ptrTaskDescriptor;
+	ptrTaskDescriptor->gptrTaskNext = gptrTaskPoolFree;
+	gptrTaskPoolFree = ptrTaskDescriptor;
+	MINIRTOS_CORE_UNLOCK();
+	MINIRTOS_EXIT_CRITICAL();
+
+	return true;
+}
+#endif
+/*****************************************************************************
+ * @brief Link a task at the end of the task list and reset its run time state.
+ *
+ * @details taskPointer, taskInterval and taskStatus have been set by the caller,
+ *   the task is planned from them.
+ *
+ * @note To be called inside a critical section.
+ *****************************************************************************/
+static void minirtos_LinkTask(Core_Descriptor_t *ptrCore, Task_Descriptor_t *ptrTaskDescriptor)
+{
+	Task_Descriptor_t *ptrWorkTask; /* Work pointer on the last task of the list */
+
+    if (ptrCore->gptrTaskFirst != NULL)
+    {
+        /* The list is circular and doubly linked, the last task is the one before the first task*/
+        ptrWorkTask = ptrCore->gptrTaskFirst->gptrTaskPrev;
+        /* Replace the last task->next task pointer with new task at the end of the circular linked list*/
+        ptrWorkTask->gptrTaskNext = ptrTaskDescriptor;
+        ptrTaskDescriptor->gptrTaskPrev = ptrWorkTask;
+        /* The new task is linked back at the first task*/
+        ptrTaskDescriptor->gptrTaskNext = ptrCore->gptrTaskFirst;
+        ptrCore->gptrTaskFirst->gptrTaskPrev = ptrTaskDescriptor;
+    }
+    else
+    {
+        /* There is no task in the scheduler, this task become the First task in the circular linked list*/
+    	/* The gptrTaskFirst pointer is initialized with the New Task*/
+    	ptrCore->gptrTaskFirst = ptrTaskDescriptor;
+    	/* Initialize the scheduled task pointer at the first task*/
+    	ptrCore->gptrTaskSchedule = ptrCore->gptrTaskFirst;
+    	/* The next and previous tasks are itself because there is just one task in the circular linked list*/
+        ptrTaskDescriptor->gptrTaskNext = ptrTaskDescriptor;
+        ptrTaskDescriptor->gptrTaskPrev = ptrTaskDescriptor;
+    }
+
+    /*Tasks with ONE SHOT or RUN NOW are planned immediately*/
+    if(ptrTaskDescriptor->taskStatus == TASK_RUN_NOW || ptrTaskDescriptor->taskStatus == TASK_ONE_SHOT_NOW ||
+       ptrTaskDescriptor->taskStatus == TASK_EVENT)
+    {
+    	ptrTaskDescriptor->plannedTask = minirtos_GetTicks();
+    }
+    else
+    {
+    	ptrTaskDescriptor->plannedTask = minirtos_GetTicks() + ptrTaskDescriptor->taskInterval;
+    }
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+    ptrTaskDescriptor->heapIndex = MINIRTOS_HEAP_INVALID;
+#endif
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+    ptrTaskDescriptor->taskPriority = MINIRTOS_CFG_DEFAULT_PRIORITY;
+#endif
+#if (MINIRTOS_READY_LEVELS > 0)
+    ptrTaskDescriptor->gptrReadyNext = NULL;
+    ptrTaskDescriptor->gptrReadyPrev = NULL;
+#endif
+#if (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+    ptrTaskDescriptor->gptrBatchNext = NULL;
+#endif
+#if (MINIRTOS_CFG_DRIFT_FREE == 1) && (MINIRTOS_CFG_OVERRUN_POLICY == MINIRTOS_OVERRUN_CATCH_UP)
+    ptrTaskDescriptor->catchUpCount = 0;
+#endif
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    ptrTaskDescriptor->taskBudget = 0;
+    ptrTaskDescriptor->budgetOverruns = 0;
+#endif
+#if (MINIRTOS_CFG_COROUTINES == 1)
+    ptrTaskDescriptor->coLine = 0;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_COROUTINES == 1)
+    ptrTaskDescriptor->ptrWaitQueue = NULL;
+    ptrTaskDescriptor->gptrWaitNext = NULL;
+#endif
+#if (MINIRTOS_CFG_CORES > 1)
+    ptrTaskDescriptor->taskCore = (uint8_t)MINIRTOS_CORE_ID();
+#endif
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    ptrTaskDescriptor->taskEvents = 0;
+    ptrTaskDescriptor->runEvents = 0;
+#endif
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+    memset(&ptrTaskDescriptor->taskStats, 0, sizeof(Task_Stats_t));
+#endif
+    minirtos_TaskChanged(ptrTaskDescriptor);
+
+    ptrCore->numberOfTasks++;
+}
+#if (MINIRTOS_CFG_EDF == 1)
+/*****************************************************************************
+ * @brief Get the CPU share of an EDF task for the admission test.
+ *
+ * @details WCET / interval in units of MINIRTOS_EDF_MAX_UTILIZATION, 0 for a task
+ *   without declared WCET.
+ *
+ * @return False if the task can not complete within its interval.
+ *****************************************************************************/
+static bool minirtos_Edf_Utilization(uint32_t taskWcet, uint32_t taskInterval, uint32_t *ptrUtilization)
+{
+    *ptrUtilization = 0;
+    if (taskWcet != 0)
+    {
+        if ((taskInterval == 0) || (taskWcet > taskInterval))
+        {
+            return false;
+        }
+        *ptrUtilization = (uint32_t)(((uint64_t)taskWcet * MINIRTOS_EDF_MAX_UTILIZATION) / taskInterval);
+    }
+    return true;
+}
+#endif
+/*****************************************************************************
+ * @brief Link a new task in the scheduler.
+ *
+ * @details Common part of the minirtos_AddTask() variants, the parameters are
+ *   the ones of minirtos_AddTaskDeadline() and the context of minirtos_AddTaskContext()
+ *   (NULL for a plain task). They are only stored in the descriptor once every
+ *   check passed, a refused call leaves the descriptor untouched.
+ *****************************************************************************/
+static bool minirtos_InsertTask(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void), void *ptrContext,
+                    uint32_t taskInterval, Task_Status_e taskStatus,
+                    uint32_t taskDeadline, uint32_t taskWcet)
+{
+	Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+
+    if ((glbInitialized == false) || (ptrCore->numberOfTasks == MAX_TASKS_NUMBER) || (ptrUserTask == NULL))
+    {
+        return false;
+    }
+    if (taskInterval > MAX_TASK_INTERVAL)
+    {
+        taskInterval = DEFAULT_TASK_INTERVAL;
+    }
+
+    /*check if taskStatus is valid, if not schedule*/
+    switch(taskStatus) {
+        case TASK_PAUSE:
+
+            break;
+        case TASK_SCHEDULED:
+
+            break;
+        case TASK_ONE_SHOT:
+
+            break;
+        case TASK_RUN_NOW:
+
+            break;
+        case TASK_ONE_SHOT_NOW:
+
+            break;
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+        case TASK_EVENT:
+
+            break;
+#endif
+        case TASK_NOT_FOUND:
+        case TASK_RUNNING:
+        default:
+        	taskStatus = TASK_SCHEDULED;
+            break;
+    }
+    if (ptrTaskDescriptor != NULL)
+        {
+#if (MINIRTOS_CFG_EDF == 1)
+            /* Admission test, the new task must not overload the CPU */
+            uint32_t taskUtilization;
+
+            if (!minirtos_Edf_Utilization(taskWcet, taskInterval, &taskUtilization))
+            {
+                return false;
+            }
+            if (taskDeadline == 0)
+            {
+                /* Implicit deadline, the task has to complete before its next release */
+                taskDeadline = taskInterval;
+            }
+#else
+            (void)taskDeadline;
+            (void)taskWcet;
+#endif
+            MINIRTOS_ENTER_CRITICAL();
+            /* A task already in the scheduler would be linked twice and break the ring */
+            if (ptrTaskDescriptor->gptrTaskPrev != NULL)
+            {
+                MINIRTOS_EXIT_CRITICAL();
+                return false;
+            }
+#if (MINIRTOS_CFG_EDF == 1)
+            if ((ptrCore->utilization + taskUtilization) > MINIRTOS_EDF_MAX_UTILIZATION)
+            {
+                MINIRTOS_EXIT_CRITICAL();
+                return false;
+            }
+            ptrCore->utilization += taskUtilization;
+            ptrTaskDescriptor->taskUtilization = taskUtilization;
+            ptrTaskDescriptor->taskDeadline = taskDeadline;
+            ptrTaskDescriptor->taskWcet = taskWcet;
+#endif
+            // Set the period, the status and the body of the task
+            ptrTaskDescriptor->taskInterval = taskInterval;
+            ptrTaskDescriptor->taskStatus = taskStatus;
+            ptrTaskDescriptor->taskPointer = ptrUserTask;
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+            /* Stored with the body, the context tells minirtos_CallTask() how to call it */
+            ptrTaskDescriptor->taskContext = ptrContext;
+#else
+            (void)ptrContext;
+#endif
+            minirtos_LinkTask(ptrCore, ptrTaskDescriptor);
+            MINIRTOS_EXIT_CRITICAL();
+
+            return true;
+        }
+    return false;
+}
+#if (MINIRTOS_CFG_CORES > 1)
+/*****************************************************************************
+ * @brief Post a message to the mailbox of another core.
+ *
+ * @details Each core sends through its own single producer / single consumer queue,
+ *   interrupts are only disabled on the calling core so its tasks and interrupts do
+ *   not produce at the same time. The other core is then signalled.
+ *
+ * @return False if the mailbox is full
+ *****************************************************************************/
+static bool minirtos_Core_Post(uint8_t taskCore, Task_Descriptor_t *ptrTask, uint8_t messageType, uint32_t taskEvents)
+{
+	Core_Message_t message;
+	bool posted;
+
+	message.ptrTask = ptrTask;
+	message.taskEvents = taskEvents;
+	message.messageType = messageType;
+	{
+		MINIRTOS_ENTER_CRITICAL();
+		posted = minirtos_Queue_SendSPSC(&glbCore[taskCore].coreMailbox[MINIRTOS_CORE_ID()], &message);
+		MINIRTOS_EXIT_CRITICAL();
+	}
+	if (posted)
+	{
+		MINIRTOS_CORE_SIGNAL(taskCore);
+	}
+	return posted;
+}
+
+/*****************************************************************************
+ * @brief Handle the messages posted to a core by the other cores.
+ *
+ * @param ptrCore   Scheduler instance of the calling core.
+ *****************************************************************************/
+static void minirtos_Core_Receive(Core_Descriptor_t *ptrCore)
+{
+	Core_Message_t message;
+
+	for (uint8_t sender = 0; sender < MINIRTOS_CFG_CORES; sender++)
+	{
+		while (minirtos_Queue_ReceiveSPSC(&ptrCore->coreMailbox[sender], &message))
+		{
+			Task_Descriptor_t *ptrTask = message.ptrTask;
+
+			if (message.messageType == MINIRTOS_CORE_MSG_ADD)
+			{
+				/* The sender filled in the parameters of the task, the admission test runs here */
+#if (MINIRTOS_CFG_EDF == 1)
+				if (!minirtos_InsertTask(ptrTask, ptrTask->taskPointer, NULL, ptrTask->taskInterval, ptrTask->taskStatus,
+				                         ptrTask->taskDeadline, ptrTask->taskWcet))
+#else
+				if (!minirtos_InsertTask(ptrTask, ptrTask->taskPointer, NULL, ptrTask->taskInterval, ptrTask->taskStatus, 0, 0))
+#endif
+				{
+					/* Refused (full or overloaded core), reported by minirtos_GetTaskStatus() */
+					ptrTask->taskStatus = TASK_NOT_FOUND;
+				}
+			}
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+			else
+			{
+				(void)minirtos_NotifyTask(ptrTask, message.taskEvents);
+			}
+#endif
+		}
+	}
+}
+#endif
+/*****************************************************************************
+ * @brief Add the task in the scheduler.
+ *
+ * @details Add a task at the end of the circular linked list for the scheduler.
+ *   The last task is found through the previous link of the first task, so the
+ *   insertion is O(1). The descriptor must not be in the scheduler: it is zero
+ *   initialized (static storage), from minirtos_TaskPool_Acquire() or removed.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrUserTask         Function pointer on the task body
+ *
+ * @param taskInterval Scheduled interval in milliseconds at which you want your
+ *                     routine to be executed.
+ *
+ * @param taskStatus Status of the task to be added to the scheduler, status can
+ *                   be:
+ *                   PAUSE, for a task that doesn't have to start immediately;
+ *                   SCHEDULED, for a normal task that has to start after its scheduling;
+ *                   ONE_SHOT, for a task that has to run only once;
+ *                   RUN_NOW, for a task that has to be executed once it
+ *                   has been added to the scheduler;
+ *                   ONE_SHOT_NOW, for a task that as to be executed now and it will only be
+ *                   executed one time.
+ *
+ * @return True or False (false as well if the task is already in the scheduler)
+ *
+ * @see @Task_Status_e, @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_AddTask(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus)
+{
+#if (MINIRTOS_CFG_EDF == 1)
+	/* Deadline equal to the interval, no declared execution time */
+	return minirtos_AddTaskDeadline(ptrTaskDescriptor, ptrUserTask, taskInterval, taskStatus, 0, 0);
+#else
+	return minirtos_InsertTask(ptrTaskDescriptor, ptrUserTask, NULL, taskInterval, taskStatus, 0, 0);
+#endif
+}
+/*****************************************************************************
+ * @brief Add the task in the scheduler with a phase offset.
+ *
+ * @details Same as minirtos_AddTask(), but the first start is taskPhase ticks from
+ *   now, for a RUN NOW task as well. Tasks sharing an interval with different
+ *   phases run on different ticks, which spreads the load of heavy tasks. A paused
+ *   or event task gets no phase.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrUserTask         Function pointer on the task body
+ *
+ * @param taskInterval Scheduled interval in milliseconds.
+ *
+ * @param taskPhase    Delay of the first start in milliseconds, up to MAX_TASK_INTERVAL.
+ *
+ * @param taskStatus   Status of the task, see minirtos_AddTask().
+ *
+ * @return True or False
+ *
+ * @see @Task_Status_e, @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_AddTaskPhase(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, uint32_t taskPhase, Task_Status_e taskStatus)
+{
+	bool added;
+
+	if (taskPhase > MAX_TASK_INTERVAL)
+	{
+		return false;
+	}
+
+	/* No scheduler pass may see the task before its phase is set */
+	MINIRTOS_ENTER_CRITICAL();
+	added = minirtos_AddTask(ptrTaskDescriptor, ptrUserTask, taskInterval, taskStatus);
+	if (added && (ptrTaskDescriptor->taskStatus != TASK_PAUSE) && (ptrTaskDescriptor->taskStatus != TASK_EVENT))
+	{
+		ptrTaskDescriptor->plannedTask = minirtos_GetTicks() + taskPhase;
+		minirtos_TaskChanged(ptrTaskDescriptor);
+	}
+	MINIRTOS_EXIT_CRITICAL();
+
+	return added;
+}
+#if (MINIRTOS_CFG_EDF == 1)
+/*****************************************************************************
+ * @brief Add an EDF task with its deadline and worst case execution time.
+ *
+ * @details Same as minirtos_AddTask(), the task is rejected if its utilization
+ *   (WCET / interval) would bring the total utilization above 100%.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrUserTask         Function pointer on the task body
+ *
+ * @param taskInterval Scheduled interval in milliseconds.
+ *
+ * @param taskStatus   Status of the task, see minirtos_AddTask().
+ *
+ * @param taskDeadline Deadline in milliseconds relative to each planned start,
+ *                     0 for a deadline equal to the interval.
+ *
+ * @param taskWcet     Worst case execution time in milliseconds, 0 if unknown
+ *                     (the task is then always admitted).
+ *
+ * @return True or False
+ *
+ * @see @Task_Status_e, @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_AddTaskDeadline(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus,
+                    uint32_t taskDeadline, uint32_t taskWcet)
+{
+	return minirtos_InsertTask(ptrTaskDescriptor, ptrUserTask, NULL, taskInterval, taskStatus, taskDeadline, taskWcet);
+}
+#endif
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+/*****************************************************************************
+ * @brief Add a task whose body is called with a context pointer.
+ *
+ * @details Same as minirtos_AddTask(), the body gets the context on every run, so
+ *   the instances of a driver share one body with a descriptor and a context each.
+ *   With EDF the task gets an implicit deadline and no declared execution time.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrUserTask         Function pointer on the task body
+ *
+ * @param ptrContext   Argument of the task body, not NULL (e.g. the instance state).
+ *
+ * @param taskInterval Scheduled interval in milliseconds.
+ *
+ * @param taskStatus   Status of the task, see minirtos_AddTask().
+ *
+ * @return True or False
+ *
+ * @see @Task_Status_e, @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_AddTaskContext(Task_Descriptor_t *ptrTaskDescriptor, gptr_Task_Context_Function ptrUserTask,
+                    void *ptrContext, uint32_t taskInterval, Task_Status_e taskStatus)
+{
+	if (ptrContext == NULL)
+	{
+		return false;
+	}
+
+	/* Called back with its own type by minirtos_CallTask() */
+	return minirtos_InsertTask(ptrTaskDescriptor, (gptr_Task_Function)ptrUserTask, ptrContext,
+	                           taskInterval, taskStatus, 0, 0);
+}
+#endif
+#if (MINIRTOS_CFG_CORES > 1)
+/*****************************************************************************
+ * @brief Add a task on a given core.
+ *
+ * @details Common part of minirtos_AddTaskOnCore() and minirtos_AddTaskDeadlineOnCore().
+ *   The parameters of a task for another core travel in its descriptor, which
+ *   the other core checks (admission test included) and links.
+ *****************************************************************************/
+static bool minirtos_Core_AddTask(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus,
+                    uint32_t taskDeadline, uint32_t taskWcet, uint8_t taskCore)
+{
+	if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || (ptrUserTask == NULL) ||
+		(taskCore >= MINIRTOS_CFG_CORES))
+	{
+		return false;
+	}
+	if (taskCore == MINIRTOS_CORE_ID())
+	{
+#if (MINIRTOS_CFG_EDF == 1)
+		return minirtos_AddTaskDeadline(ptrTaskDescriptor, ptrUserTask, taskInterval, taskStatus, taskDeadline, taskWcet);
+#else
+		return minirtos_AddTask(ptrTaskDescriptor, ptrUserTask, taskInterval, taskStatus);
+#endif
+	}
+	if (ptrTaskDescriptor->gptrTaskPrev != NULL)
+	{
+		return false; // Still in a scheduler, its parameters must not be touched
+	}
+
+	/* Parameters handed over to minirtos_InsertTask() on the other core */
+	ptrTaskDescriptor->taskPointer = ptrUserTask;
+	ptrTaskDescriptor->taskInterval = taskInterval;
+	ptrTaskDescriptor->taskStatus = taskStatus;
+	ptrTaskDescriptor->taskCore = taskCore;
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+	ptrTaskDescriptor->taskContext = NULL;
+#endif
+#if (MINIRTOS_CFG_EDF == 1)
+	ptrTaskDescriptor->taskDeadline = taskDeadline;
+	ptrTaskDescriptor->taskWcet = taskWcet;
+#else
+	(void)taskDeadline;
+	(void)taskWcet;
+#endif
+
+	return minirtos_Core_Post(taskCore, ptrTaskDescriptor, MINIRTOS_CORE_MSG_ADD, 0);
+}
 /*****************************************************************************
- * @brief Create/init a queue instance.
+ * @brief Add the task in the scheduler of a given core.
  *
- * @details Creates a new queue for application/user.
+ * @details Same as minirtos_AddTask() with the affinity of the task. A task for
+ *   another core is posted to the mailbox of that core and linked there on its next
+ *   scheduler pass, so the task only ever runs on its own core. The task can then
+ *   only be removed, paused, resumed or modified from that core. If that core
+ *   refuses the task (no room left or, with EDF, an overload) its status becomes
+ *   TASK_NOT_FOUND.
  *
- * @param ptrq   Descriptor of the queue.
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrUserTask         Function pointer on the task body
+ *
+ * @param taskInterval Scheduled interval in milliseconds.
+ *
+ * @param taskStatus   Status of the task, see minirtos_AddTask().
+ *
+ * @param taskCore     Core running the task.
+ *
+ * @return True or False (false as well if the mailbox of the core is full)
+ *
+ * @see @Task_Status_e, @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_AddTaskOnCore(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus, uint8_t taskCore)
+{
+	/* Deadline equal to the interval, no declared execution time */
+	return minirtos_Core_AddTask(ptrTaskDescriptor, ptrUserTask, taskInterval, taskStatus, 0, 0, taskCore);
+}
+#if (MINIRTOS_CFG_EDF == 1)
+/*****************************************************************************
+ * @brief Add an EDF task with its deadline and WCET in the scheduler of a given core.
+ *
+ * @details Same as minirtos_AddTaskOnCore(), the admission test of
+ *   minirtos_AddTaskDeadline() is run against the utilization of taskCore by that
+ *   core when it links the task. A refused task gets the status TASK_NOT_FOUND.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrUserTask         Function pointer on the task body
+ *
+ * @param taskInterval Scheduled interval in milliseconds.
+ *
+ * @param taskStatus   Status of the task, see minirtos_AddTask().
+ *
+ * @param taskDeadline Deadline in milliseconds relative to each planned start,
+ *                     0 for a deadline equal to the interval.
+ *
+ * @param taskWcet     Worst case execution time in milliseconds, 0 if unknown.
+ *
+ * @param taskCore     Core running the task.
+ *
+ * @return True or False (false as well if the mailbox of the core is full, or
+ *         right away if taskCore is the calling core and the task is refused)
+ *
+ * @see @Task_Status_e, @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_AddTaskDeadlineOnCore(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus,
+                    uint32_t taskDeadline, uint32_t taskWcet, uint8_t taskCore)
+{
+	return minirtos_Core_AddTask(ptrTaskDescriptor, ptrUserTask, taskInterval, taskStatus,
+	                             taskDeadline, taskWcet, taskCore);
+}
+#endif
+#endif
+/*****************************************************************************
+ * @brief Add a table of tasks declared at build time.
+ *
+ * @details The table is built with MINIRTOS_TASK_ENTRY(), so the descriptors are
+ *   initialized by the startup code and lie next to each other in memory. All the
+ *   entries are checked first, then linked in one critical section without the
+ *   parameter fix-ups of minirtos_AddTask(): the whole table is added or none of it.
+ *   With EDF the admission test is run for the table as a whole, the entries of
+ *   MINIRTOS_TASK_ENTRY_DEADLINE() declare a deadline and a WCET.
+ *
+ * @param ptrTaskTable    First descriptor of the table.
+ *
+ * @param numberOfTasks   Number of entries, see MINIRTOS_TASK_COUNT().
+ *
+ * @return False if an entry is invalid or already in the scheduler, or if the
+ *         table does not fit in the scheduler (or would overload the CPU with EDF).
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_AddTaskTable(Task_Descriptor_t *ptrTaskTable, uint8_t numberOfTasks)
+{
+	Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+#if (MINIRTOS_CFG_EDF == 1)
+	uint32_t tableUtilization = 0; /* At most 255 tasks of MINIRTOS_EDF_MAX_UTILIZATION each */
+#endif
+
+	if ((glbInitialized == false) || (ptrTaskTable == NULL) ||
+		(numberOfTasks > (MAX_TASKS_NUMBER - ptrCore->numberOfTasks)))
+	{
+		return false;
+	}
+	for (uint8_t index = 0; index < numberOfTasks; index++)
+	{
+		const Task_Descriptor_t *ptrTask = &ptrTaskTable[index];
+
+		if ((ptrTask->taskPointer == NULL) || (ptrTask->taskInterval > MAX_TASK_INTERVAL) ||
+			(ptrTask->taskStatus > TASK_ONE_SHOT_NOW) || (ptrTask->gptrTaskPrev != NULL))
+		{
+			return false;
+		}
+#if (MINIRTOS_CFG_TASK_EVENTS == 0)
+		if (ptrTask->taskStatus == TASK_EVENT)
+		{
+			return false;
+		}
+#endif
+#if (MINIRTOS_CFG_EDF == 1)
+		uint32_t taskUtilization;
+
+		if (!minirtos_Edf_Utilization(ptrTask->taskWcet, ptrTask->taskInterval, &taskUtilization))
+		{
+			return false;
+		}
+		tableUtilization += taskUtilization;
+#endif
+	}
+
+	MINIRTOS_ENTER_CRITICAL();
+#if (MINIRTOS_CFG_EDF == 1)
+	/* Admission test of the whole table */
+	if ((ptrCore->utilization + tableUtilization) > MINIRTOS_EDF_MAX_UTILIZATION)
+	{
+		MINIRTOS_EXIT_CRITICAL();
+		return false;
+	}
+	ptrCore->utilization += tableUtilization;
+#endif
+	for (uint8_t index = 0; index < numberOfTasks; index++)
+	{
+#if (MINIRTOS_CFG_EDF == 1)
+		if (ptrTaskTable[index].taskDeadline == 0)
+		{
+			ptrTaskTable[index].taskDeadline = ptrTaskTable[index].taskInterval;
+		}
+		(void)minirtos_Edf_Utilization(ptrTaskTable[index].taskWcet, ptrTaskTable[index].taskInterval,
+		                               &ptrTaskTable[index].taskUtilization);
+#endif
+		minirtos_LinkTask(ptrCore, &ptrTaskTable[index]);
+	}
+	MINIRTOS_EXIT_CRITICAL();
+
+	return true;
+}
+/*****************************************************************************
+ * @brief Remove the task from the scheduler.
+ *
+ * @details This function is used to remove the task from the scheduler. The task is
+ *   unlinked from its neighbours in O(1), a task may also remove itself.
+ *
+ * @param Task_Descriptor_t Descriptor of the task to be removed.
+ *
+ * @return Return true if all went well, false otherwise.
+ *
+ * @return True or False
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_RemoveTask(Task_Descriptor_t *ptrUserTaskDescriptor)
+{
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+
+    if ((glbInitialized == false) || (ptrCore->numberOfTasks == 0) || (ptrUserTaskDescriptor == NULL) ||
+        !minirtos_IsTaskLocal(ptrUserTaskDescriptor))
+    {
+        return false;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    /* A task which is not in the scheduler has no neighbours */
+    if (ptrUserTaskDescriptor->gptrTaskPrev == NULL)
+    {
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
+    }
+
+    if (ptrUserTaskDescriptor->gptrTaskNext == ptrUserTaskDescriptor)
+    {
+    	/* This was the only task, the circular linked list is now empty */
+    	ptrCore->gptrTaskFirst = NULL;
+    	ptrCore->gptrTaskSchedule = NULL;
+    }
+    else
+    {
+    	/* Link the previous and the next task together */
+    	ptrUserTaskDescriptor->gptrTaskPrev->gptrTaskNext = ptrUserTaskDescriptor->gptrTaskNext;
+    	ptrUserTaskDescriptor->gptrTaskNext->gptrTaskPrev = ptrUserTaskDescriptor->gptrTaskPrev;
+
+    	if (ptrUserTaskDescriptor == ptrCore->gptrTaskFirst)
+    	{
+    		ptrCore->gptrTaskFirst = ptrUserTaskDescriptor->gptrTaskNext;
+    	}
+    	/* The scheduler moves on from gptrTaskSchedule after a task ran, step back so
+    	 * the task following the removed one is not skipped (e.g. a task removing itself) */
+    	if (ptrUserTaskDescriptor == ptrCore->gptrTaskSchedule)
+    	{
+    		ptrCore->gptrTaskSchedule = ptrUserTaskDescriptor->gptrTaskPrev;
+    	}
+    }
+
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+    minirtos_Heap_Remove(ptrCore, ptrUserTaskDescriptor);
+#endif
+#if (MINIRTOS_READY_LEVELS > 0)
+    minirtos_Ready_Remove(ptrCore, ptrUserTaskDescriptor);
+#endif
+#if (MINIRTOS_CFG_EDF == 1)
+    ptrCore->utilization -= ptrUserTaskDescriptor->taskUtilization;
+    ptrUserTaskDescriptor->taskUtilization = 0;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_COROUTINES == 1)
+    minirtos_Co_Unpark(ptrUserTaskDescriptor);
+#endif
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    if (ptrUserTaskDescriptor->taskBudget != 0)
+    {
+    	/* The watchdog no longer waits for this task */
+    	if (ptrUserTaskDescriptor->checkInRound == ptrCore->checkInRound)
+    	{
+    		ptrCore->checkedIn--;
+    	}
+    	ptrCore->watchedTasks--;
+    	ptrUserTaskDescriptor->taskBudget = 0;
+    }
+#endif
+    ptrUserTaskDescriptor->gptrTaskNext = NULL;
+    ptrUserTaskDescriptor->gptrTaskPrev = NULL;
+    ptrCore->numberOfTasks--;
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+/*****************************************************************************
+ * @brief Pause the task in the scheduler.
+ *
+ * @details This function is used to pause the task on the scheduler.
+ *
+ * @param Task_Descriptor_t Descriptor of the task to be removed.
+ *
+ * @return Return true if all went well, false otherwise.
+ *
+ * @return True or False
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_PauseTask(Task_Descriptor_t *ptrTaskDescriptor)
+{
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || !minirtos_IsTaskLocal(ptrTaskDescriptor))
+    {
+        return false;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTaskDescriptor->gptrTaskPrev == NULL)
+    {
+    	/* Not in the scheduler */
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
+    }
+    ptrTaskDescriptor->taskStatus = TASK_PAUSE;
+    minirtos_TaskChanged(ptrTaskDescriptor);
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+/*****************************************************************************
+ * @brief Resume the task in the scheduler.
+ *
+ * @details This function is used to restart a task that has been paused.
+ *
+ * @param Task_Descriptor_t Descriptor of the task to be removed.
+ *
+ * @return Return true if all went well, false otherwise.
+ *
+ * @return True or False
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_ResumeTask(Task_Descriptor_t *ptrTaskDescriptor)
+{
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || !minirtos_IsTaskLocal(ptrTaskDescriptor))
+    {
+        return false;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTaskDescriptor->gptrTaskPrev == NULL)
+    {
+    	/* Not in the scheduler */
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
+    }
+    ptrTaskDescriptor->taskStatus = TASK_SCHEDULED;
+
+    ptrTaskDescriptor->plannedTask = minirtos_GetTicks() + ptrTaskDescriptor->taskInterval;
+    minirtos_TaskChanged(ptrTaskDescriptor);
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+/*****************************************************************************
+ * @brief Modify the task in the scheduler.
+ *
+ * @details This function is used to modify a task parameters.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrUserTask         Function pointer on the task body
+ *
+ * @param taskInterval Scheduled interval in milliseconds at which you want your
+ *                     routine to be executed.
+ *
+ * @param taskStatus Status of the task to be added to the scheduler, status can
+ *                   be:
+ *                   PAUSE, for a task that doesn't have to start immediately;
+ *                   SCHEDULED, for a normal task that has to start after its scheduling;
+ *                   ONE_SHOT, for a task that has to run only once;
+ *                   RUN_NOW, for a task that has to be executed once it
+ *                   has been added to the scheduler;
+ *                   ONE_SHOT_NOW, for a task that as to be executed now and it will only be
+ *                   executed one time.
+ *
+ * @return True or False
+ *
+ * @see @Task_Status_e, @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_ModifyTask(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskInterval, Task_Status_e taskStatus)
+{
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || !minirtos_IsTaskLocal(ptrTaskDescriptor))
+    {
+        return false;
+    }
+
+    if (taskStatus > TASK_ONE_SHOT_NOW)
+    {
+        return false;
+    }
+#if (MINIRTOS_CFG_TASK_EVENTS == 0)
+    if (taskStatus == TASK_EVENT)
+    {
+        return false;
+    }
+#endif
+
+#if (MINIRTOS_CFG_EDF == 1)
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+    uint32_t taskUtilization;
+
+    if (!minirtos_Edf_Utilization(ptrTaskDescriptor->taskWcet, taskInterval, &taskUtilization))
+    {
+    	return false;
+    }
+#endif
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTaskDescriptor->gptrTaskPrev == NULL)
+    {
+    	/* Not in the scheduler */
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
+    }
+#if (MINIRTOS_CFG_EDF == 1)
+    if (ptrTaskDescriptor->taskWcet != 0)
+    {
+    	/* The new interval changes the CPU share of the task, run the admission test again */
+    	if ((ptrCore->utilization - ptrTaskDescriptor->taskUtilization + taskUtilization) > MINIRTOS_EDF_MAX_UTILIZATION)
+    	{
+    		MINIRTOS_EXIT_CRITICAL();
+    		return false;
+    	}
+    	ptrCore->utilization = ptrCore->utilization - ptrTaskDescriptor->taskUtilization + taskUtilization;
+    	ptrTaskDescriptor->taskUtilization = taskUtilization;
+    }
+#endif
+    ptrTaskDescriptor->taskInterval = taskInterval;
+    ptrTaskDescriptor->taskStatus = taskStatus;
+
+    if (taskStatus == TASK_SCHEDULED || taskStatus == TASK_ONE_SHOT)
+    {
+    	ptrTaskDescriptor->plannedTask = minirtos_GetTicks() + taskInterval;
+    }
+    else
+    {
+    	/* RUN NOW tasks are planned immediately */
+    	ptrTaskDescriptor->plannedTask = minirtos_GetTicks();
+    }
+    minirtos_TaskChanged(ptrTaskDescriptor);
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+/*****************************************************************************
+ * @brief Get status of the tasks.
+ *
+ * @details Function to check if a task is running or paused etc.
+ *
+ * @param Task_Descriptor_t Descriptor of the task to be removed.
+ *
+ * @return taskStatus Status of the task to be added to the scheduler, status can
+ *                   be:
+ *                   PAUSE, for a task that doesn't have to start immediately;
+ *                   SCHEDULED, for a normal task that has to start after its scheduling;
+ *                   ONE_SHOT, for a task that has to run only once;
+ *                   RUN_NOW, for a task that has to be executed once it
+ *                   has been added to the scheduler;
+ *                   ONE_SHOT_NOW, for a task that as to be executed now and it will only be
+ *                   executed one time.
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+Task_Status_e minirtos_GetTaskStatus(Task_Descriptor_t *ptrTaskDescriptor)
+{
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL))
+    {
+        return TASK_NOT_FOUND;
+    }
+
+    return (Task_Status_e)ptrTaskDescriptor->taskStatus;
+}
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+/*****************************************************************************
+ * @brief Set the priority of a task.
+ *
+ * @details Tasks are added with MINIRTOS_CFG_DEFAULT_PRIORITY. A due task is
+ *   always run before the due tasks of a lower priority, tasks of the same
+ *   priority are run round-robin.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param taskPriority        New priority, 0 is the highest and
+ *                            MINIRTOS_CFG_PRIORITY_LEVELS - 1 the lowest.
+ *
+ * @return True or False
+ *
+ * @see @Task_Descriptor_t
+ *****************************************************************************/
+bool minirtos_SetTaskPriority(Task_Descriptor_t *ptrTaskDescriptor, uint8_t taskPriority)
+{
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || (taskPriority >= MINIRTOS_CFG_PRIORITY_LEVELS) ||
+        !minirtos_IsTaskLocal(ptrTaskDescriptor))
+    {
+        return false;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTaskDescriptor->gptrReadyPrev != NULL)
+    {
+    	/* Move a ready task to the ring of its new priority */
+    	minirtos_Ready_Remove(ptrCore, ptrTaskDescriptor);
+    	ptrTaskDescriptor->taskPriority = taskPriority;
+    	minirtos_Ready_Push(ptrCore, ptrTaskDescriptor);
+    }
+    else
+    {
+    	ptrTaskDescriptor->taskPriority = taskPriority;
+    }
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+#endif
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+/*****************************************************************************
+ * @brief Notify events to a task.
  *
- * @param buffer User allocated queue space for operation
+ * @details The events are or-ed into the pending events of the task and the task
+ *   is planned at the current tick, so it runs on the next scheduler pass instead
+ *   of waiting for its interval. A paused task only keeps the events. Can be
+ *   called from interrupt context.
  *
- * @param elementSize Size of each element in the queue.
+ * @param ptrTaskDescriptor   Descriptor of the task.
  *
- * @param maxElementrs Maximum elements allowed in particular queue
+ * @param taskEvents   Event bits, must not be 0.
  *
  * @return True or False
- *
- * @see @Queue_Descriptor_t
  *****************************************************************************/
-bool minirtos_Queue_Create(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements)
+bool minirtos_NotifyTask(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskEvents)
 {
-    if (!ptrq || !buffer || elementSize == 0 || maxElements == 0)
-    	{
-    		return false;
-    	}
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || (taskEvents == 0))
+    {
+        return false;
+    }
+#if (MINIRTOS_CFG_CORES > 1)
+    if (!minirtos_IsTaskLocal(ptrTaskDescriptor))
+    {
+    	/* The owning core delivers the events on its next scheduler pass */
+    	return minirtos_Core_Post(ptrTaskDescriptor->taskCore, ptrTaskDescriptor, MINIRTOS_CORE_MSG_NOTIFY, taskEvents);
+    }
+#endif
 
-    ptrq->buffer = buffer;
-    ptrq->elementSize = elementSize;
-    if (maxElements > MAX_NO_OF_QUEUE_ELEMENTS)
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTaskDescriptor->gptrTaskPrev == NULL)
     {
-    	ptrq->maxElements = MAX_NO_OF_QUEUE_ELEMENTS;
+    	/* Not in the scheduler */
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
     }
-    else
+    ptrTaskDescriptor->taskEvents |= taskEvents;
+    if (minirtos_IsTaskActive(ptrTaskDescriptor))
     {
-    	ptrq->maxElements = maxElements;
+    	ptrTaskDescriptor->plannedTask = minirtos_GetTicks();
+    	minirtos_TaskChanged(ptrTaskDescriptor);
     }
-    ptrq->head = 0;
-    ptrq->tail = 0;
-    ptrq->count = 0;
+    MINIRTOS_EXIT_CRITICAL();
 
     return true;
 }
+
 /*****************************************************************************
- * @brief Enqueue data into queue.
+ * @brief Get the events which woke the running task.
  *
- * @details Copies an item (of size specified at queue creation) into the queue.
- *   This function can be safely called from both main code and interrupt context, as it enters a critical
- *   section (disables interrupts) to protect the internal data structure. Operation is quick and minimal for ISR safety.
+ * @details The pending events are cleared and handed to the task each time it
+ *   is started, events notified while it runs start it once more.
  *
- * @param ptrq   Descriptor of the queue.
+ * @param ptrTaskDescriptor   Descriptor of the task.
  *
- * @param ptrmsg User message in the given queue.
+ * @return Events of the current run, 0 for a plain periodic run.
+ *****************************************************************************/
+uint32_t minirtos_GetTaskEvents(Task_Descriptor_t *ptrTaskDescriptor)
+{
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL))
+    {
+        return 0;
+    }
+
+    return ptrTaskDescriptor->runEvents;
+}
+
+#endif
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+/*****************************************************************************
+ * @brief Get a snapshot of the statistics of a task.
  *
- * @return True or False
+ * @details The statistics are copied in a critical section, so all the fields
+ *   belong to the same run even when called from an interrupt.
  *
- * @see @Queue_Descriptor_t
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ptrStats   Filled with the statistics of the task.
+ *
+ * @return True or False
  *****************************************************************************/
-bool minirtos_Queue_Send(Queue_Descriptor_t *ptrq, const void *ptrmsg)
+bool minirtos_GetTaskStats(Task_Descriptor_t *ptrTaskDescriptor, Task_Stats_t *ptrStats)
 {
-	MINIRTOS_QUEUE_ENTER_CRITICAL();
-    if (ptrq->count == ptrq->maxElements)
-    	{
-    	    MINIRTOS_QUEUE_EXIT_CRITICAL();
-    		return false; // Queue is full
-    	}
-
-    uint8_t *ptrbuf = (uint8_t *)ptrq->buffer;
-    uint16_t idx = (ptrq->tail * ptrq->elementSize);    // Calculate where to write
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || (ptrStats == NULL))
+    {
+        return false;
+    }
 
-    memcpy(&ptrbuf[idx], ptrmsg, ptrq->elementSize);       // Copy in the data
+    MINIRTOS_ENTER_CRITICAL();
+    *ptrStats = ptrTaskDescriptor->taskStats;
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    ptrStats->budgetOverruns = ptrTaskDescriptor->budgetOverruns;
+#endif
+    MINIRTOS_EXIT_CRITICAL();
 
-    ptrq->tail = (ptrq->tail + 1) % ptrq->maxElements;     // Increment/cycle tail
-    ptrq->count++;                                // Increment item count
-    MINIRTOS_QUEUE_EXIT_CRITICAL();
     return true;
 }
 
 /*****************************************************************************
- * @brief Dequeue data from queue.
- *
- * @details  Copies an item out of the queue into user memory. Can be safely called from both
- *   main code and interrupt context, as it disables interrupts during the operation to prevent data races.
- *
- * @param ptrq   Descriptor of the queue.
+ * @brief Reset the statistics of a task.
  *
- * @param ptrmsg User message removed from queue.
+ * @param ptrTaskDescriptor   Descriptor of the task.
  *
  * @return True or False
- *
- * @see @Queue_Descriptor_t
  *****************************************************************************/
-bool minirtos_Queue_Receive(Queue_Descriptor_t *ptrq, void *ptrmsg)
+bool minirtos_ResetTaskStats(Task_Descriptor_t *ptrTaskDescriptor)
 {
-	MINIRTOS_QUEUE_ENTER_CRITICAL();
-    if (ptrq->count == 0)
-    	{
-    		MINIRTOS_QUEUE_EXIT_CRITICAL();
-    		return false;           // Queue is empty
-    	}
-
-    uint8_t *ptrbuf = (uint8_t *)ptrq->buffer;
-    uint16_t idx = (ptrq->head * ptrq->elementSize);    // Where to read
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL))
+    {
+        return false;
+    }
 
-    memcpy(ptrmsg, &ptrbuf[idx], ptrq->elementSize);       // Copy out the data
+    MINIRTOS_ENTER_CRITICAL();
+    memset(&ptrTaskDescriptor->taskStats, 0, sizeof(Task_Stats_t));
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    ptrTaskDescriptor->budgetOverruns = 0;
+#endif
+    MINIRTOS_EXIT_CRITICAL();
 
-    ptrq->head = (ptrq->head + 1) % ptrq->maxElements;     // Move head forward
-    ptrq->count--;                                // Decrement item count
-    MINIRTOS_QUEUE_EXIT_CRITICAL();
     return true;
 }
-
+#endif
+#if (MINIRTOS_CFG_HRTIMER == 1)
 /*****************************************************************************
- * @brief Get number of items currently in queue.
+ * @brief Start a high resolution timer task.
  *
- * @details No of elements available in the queue.
+ * @details The timer task is inserted in the sorted due list, the compare register
+ *   is reprogrammed when it becomes the earliest one. Following runs are planned
+ *   from the previous due time, so the rate is exact whatever the interrupt latency.
+ *   A callback may restart its own timer task with another interval by calling
+ *   minirtos_HrTimer_Remove() then minirtos_HrTimer_Add(), the next run is then
+ *   planned from now and the interrupt handler does not put it back a second time.
  *
- * @param ptrq   Descriptor of the queue.
+ * @param ptrHrTask     Descriptor of the timer task, zero initialized before its first use.
  *
- * @retval no of elements present at the movement.
+ * @param ptrUserTask   Callback, runs in interrupt context.
  *
- * @see @Queue_Descriptor_t
+ * @param taskInterval  Interval in timer counts (e.g. microseconds at 1 MHz), at least 1.
+ *
+ * @return True or False
  *****************************************************************************/
-uint16_t minirtos_Queue_Count(Queue_Descriptor_t *ptrq)
+bool minirtos_HrTimer_Add(HrTask_Descriptor_t *ptrHrTask, gptr_Task_Function ptrUserTask, uint32_t taskInterval)
 {
-    return ptrq->count;
+    if ((ptrHrTask == NULL) || (ptrUserTask == NULL) || (taskInterval == 0) || (taskInterval > INT32_MAX))
+    {
+        return false;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrHrTask->taskActive)
+    {
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
+    }
+    ptrHrTask->taskPointer = ptrUserTask;
+    ptrHrTask->taskInterval = taskInterval;
+    ptrHrTask->plannedTask = MINIRTOS_HRTIMER_CNT + taskInterval;
+    ptrHrTask->taskActive = true;
+    /* Restarted by its own callback, it is in the list now and not put back after the run */
+    ptrHrTask->taskRunning = false;
+    minirtos_HrTimer_Insert(ptrHrTask);
+    if ((gptrHrTaskFirst == ptrHrTask) && !minirtos_HrTimer_Program())
+    {
+    	/* Already due, the compare match was missed, let the interrupt run it */
+    	MINIRTOS_HRTIMER_PEND();
+    }
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
 }
 
 /*****************************************************************************
- * @brief Flush (clear) all contents from the queue.
+ * @brief Stop a high resolution timer task.
  *
- * @details Resets head, tail, and count so queue is empty.
- *   Protects structure with critical section for safe use from main/IRQ context.
+ * @details Can also be called by the timer task itself.
  *
- * @param ptrq   Descriptor of the queue.
+ * @param ptrHrTask     Descriptor of the timer task.
  *
- * @return
+ * @return True or False
+ *****************************************************************************/
+bool minirtos_HrTimer_Remove(HrTask_Descriptor_t *ptrHrTask)
+{
+    HrTask_Descriptor_t **ptrLink = &gptrHrTaskFirst;
+
+    if (ptrHrTask == NULL)
+    {
+        return false;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    while ((*ptrLink != NULL) && (*ptrLink != ptrHrTask))
+    {
+    	ptrLink = &(*ptrLink)->gptrTaskNext;
+    }
+    if (*ptrLink != NULL)
+    {
+    	*ptrLink = ptrHrTask->gptrTaskNext;
+    }
+    /* A timer task removing itself is not in the list while it runs */
+    ptrHrTask->gptrTaskNext = NULL;
+    ptrHrTask->taskActive = false;
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Compare interrupt handler of the high resolution timer.
  *
- * @see @Queue_Descriptor_t
+ * @details Runs every timer task whose due time is over, plans it one interval
+ *   later and puts it back in the sorted list. Then programs the compare register
+ *   with the next due time, if that time already passed meanwhile the loop goes on
+ *   so no compare match is lost. The callbacks run with interrupts enabled, only
+ *   the list updates are in critical sections.
+ *
+ * @note To be called from the timer interrupt, after clearing its flag.
  *****************************************************************************/
-void minirtos_Queue_Flush(Queue_Descriptor_t *ptrq)
+void minirtos_HrTimer_IRQHandler(void)
 {
-	MINIRTOS_QUEUE_ENTER_CRITICAL();
-	ptrq->head = 0;
-	ptrq->tail = 0;
-	ptrq->count = 0;
-	MINIRTOS_QUEUE_EXIT_CRITICAL();
+    HrTask_Descriptor_t *ptrHrTask;
+    bool programmed = false;
+
+    while (programmed == false)
+    {
+    	{
+    		MINIRTOS_ENTER_CRITICAL();
+    		ptrHrTask = gptrHrTaskFirst;
+    		if ((ptrHrTask != NULL) && ((int32_t)(ptrHrTask->plannedTask - MINIRTOS_HRTIMER_CNT) <= ZERO))
+    		{
+    			gptrHrTaskFirst = ptrHrTask->gptrTaskNext;
+    			ptrHrTask->gptrTaskNext = NULL;
+    			ptrHrTask->taskRunning = true;
+    		}
+    		else
+    		{
+    			ptrHrTask = NULL;
+    			programmed = minirtos_HrTimer_Program();
+    		}
+    		MINIRTOS_EXIT_CRITICAL();
+    	}
+
+    	if (ptrHrTask != NULL)
+    	{
+    		ptrHrTask->taskPointer();
+
+    		MINIRTOS_ENTER_CRITICAL();
+    		/* Not put back if the callback stopped it, or restarted it (already in the list) */
+    		if (ptrHrTask->taskActive && ptrHrTask->taskRunning)
+    		{
+    			/* Drift-free, the next run is planned from this due time */
+    			ptrHrTask->plannedTask += ptrHrTask->taskInterval;
+    			minirtos_HrTimer_Insert(ptrHrTask);
+    		}
+    		ptrHrTask->taskRunning = false;
+    		MINIRTOS_EXIT_CRITICAL();
+    	}
+    }
 }
+#endif
+#if (MINIRTOS_CFG_SW_TIMERS == 1)
 /*****************************************************************************
- * @brief Entry function for the user to initiate scheduler.
+ * @brief Start or restart a software timer.
  *
- * @details This function as to be called before doing anything with the tasker. It
- * initiates the tasker subsystems. If this funtion is not called before doing
- * anything with the tasker all functions will return false.
+ * @details The timer is put in the wheel slot of its expiry tick, a running timer
+ *   is moved. Its callback is called from the scheduler pass of the expiry tick,
+ *   together with the other timers of that tick, then every period ticks.
+ *   A timer belongs to the core which started it, stop it from that core.
  *
- * @param   None
+ * @param ptrTimer      Descriptor of the timer, zero initialized before its first use.
  *
- * @return  None
+ * @param ptrCallback   Function called on expiry, receives the timer descriptor.
  *
- * @retval  None
+ * @param timeout       Ticks until the first expiry, 0 expires on the next tick.
  *
- * @note Should be called once from `main()` or before scheduler to start application.
+ * @param period        Ticks between the following expiries, 0 for a one-shot timer.
+ *
+ * @return True or False
  *****************************************************************************/
-void minirtos_Init(void)
+bool minirtos_Timer_Start(Timer_Descriptor_t *ptrTimer, gptr_Timer_Callback ptrCallback,
+                          uint32_t timeout, uint32_t period)
 {
-	glbInitialized = true;
-	glbSysTicks = 0;
-	glbNumberOfTasks = 0;
-	gptrTaskSchedule = NULL;
+    if ((glbInitialized == false) || (ptrTimer == NULL) || (ptrCallback == NULL) ||
+        (timeout > INT32_MAX) || (period > INT32_MAX))
+    {
+        return false;
+    }
+
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTimer->gptrTimerLink != NULL)
+    {
+        minirtos_Timer_Unlink(ptrTimer);
+    }
+    ptrTimer->timerCallback = ptrCallback;
+    ptrTimer->timerTimeout = timeout;
+    ptrTimer->timerPeriod = period;
+    ptrTimer->expiryTick = minirtos_GetTicks() + ((timeout != 0) ? timeout : 1);
+    minirtos_Timer_Link(ptrCore, ptrTimer);
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+    glbTaskChanged = true;
+#endif
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
 }
+
 /*****************************************************************************
- * @brief Add the task in the scheduler.
- *
- * @details Add a task into the circular linked list for the scheduler.
+ * @brief Start a software timer again with its last timeout and period.
  *
- * @param ptrTaskDescriptor   Descriptor of the task.
+ * @details Typical use is a watchdog style timeout pushed back on every event.
  *
- * @param ptrUserTask         Function pointer on the task body
+ * @param ptrTimer  Descriptor of a timer started before.
  *
- * @param taskInterval Scheduled interval in milliseconds at which you want your
- *                     routine to be executed.
+ * @return True or False
+ *****************************************************************************/
+bool minirtos_Timer_Restart(Timer_Descriptor_t *ptrTimer)
+{
+    if ((ptrTimer == NULL) || (ptrTimer->timerCallback == NULL))
+    {
+        return false;
+    }
+
+    return minirtos_Timer_Start(ptrTimer, ptrTimer->timerCallback, ptrTimer->timerTimeout, ptrTimer->timerPeriod);
+}
+
+/*****************************************************************************
+ * @brief Stop a software timer.
  *
- * @param taskStatus Status of the task to be added to the scheduler, status can
- *                   be:
- *                   PAUSE, for a task that doesn't have to start immediately;
- *                   SCHEDULED, for a normal task that has to start after its scheduling;
- *                   ONE_SHOT, for a task that has to run only once;
- *                   RUN_NOW, for a task that has to be executed once it
- *                   has been added to the scheduler;
- *                   ONE_SHOT_NOW, for a task that as to be executed now and it will only be
- *                   executed one time.
+ * @details Can be called from the callback of any timer, the timer itself included.
  *
- * @return True or False
+ * @param ptrTimer  Descriptor of the timer.
  *
- * @see @Task_Status_e, @Task_Descriptor_t
+ * @return False if the timer was not running
  *****************************************************************************/
-bool minirtos_AddTask(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
-                    uint32_t taskInterval, Task_Status_e taskStatus)
+bool minirtos_Timer_Stop(Timer_Descriptor_t *ptrTimer)
 {
-	Task_Descriptor_t *ptrNewTask = (Task_Descriptor_t *)malloc(sizeof(Task_Descriptor_t));
+    bool stopped = false;
 
-    if ((glbInitialized == false) || (glbNumberOfTasks == MAX_TASKS_NUMBER) || (ptrUserTask == NULL))
+    if ((glbInitialized == false) || (ptrTimer == NULL))
     {
-    	free(ptrNewTask);
         return false;
     }
-    if ((taskInterval < 0) || (taskInterval > MAX_TASK_INTERVAL))
+
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTimer->gptrTimerLink != NULL)
     {
-        taskInterval = DEFAULT_TASK_INTERVAL;
+        minirtos_Timer_Unlink(ptrTimer);
+        stopped = true;
     }
+    MINIRTOS_EXIT_CRITICAL();
 
-    /*check if taskStatus is valid, if not schedule*/
-    switch(taskStatus) {
-        case TASK_PAUSE:
+    return stopped;
+}
 
-            break;
-        case TASK_SCHEDULED:
+/*****************************************************************************
+ * @brief Check whether a software timer is running.
+ *
+ * @details A one-shot timer is not running any more once its callback is called.
+ *
+ * @param ptrTimer  Descriptor of the timer.
+ *
+ * @return True or False
+ *****************************************************************************/
+bool minirtos_Timer_IsActive(const Timer_Descriptor_t *ptrTimer)
+{
+    return (ptrTimer != NULL) && (ptrTimer->gptrTimerLink != NULL);
+}
+#endif
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE > 0)
+/*****************************************************************************
+ * @brief Post a call to be made by the scheduler of the calling core.
+ *
+ * @details Meant for interrupt handlers which hand their processing over to
+ *   thread level (bottom half): the call is made at the start of the next scheduler
+ *   pass, before any task, the calls posted before it first.
+ *
+ * @param ptrFunction   Function to call.
+ *
+ * @param ptrArgument   Argument passed to the function.
+ *
+ * @return False if the ring is full
+ *****************************************************************************/
+bool minirtos_Defer(gptr_Defer_Function ptrFunction, void *ptrArgument)
+{
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+    Defer_Call_t *ptrCall;
+    uint32_t slot;
 
-            break;
-        case TASK_ONE_SHOT:
+    if ((glbInitialized == false) || (ptrFunction == NULL) || !minirtos_Defer_Claim(ptrCore, &slot))
+    {
+        return false;
+    }
 
-            break;
-        case TASK_RUN_NOW:
+    ptrCall = &ptrCore->deferCalls[slot & (MINIRTOS_CFG_DEFER_QUEUE_SIZE - 1)];
+    ptrCall->ptrArgument = ptrArgument;
 
-            break;
-        case TASK_ONE_SHOT_NOW:
+    /* The argument has to be written before the scheduler can see the function */
+    __DMB();
+    ptrCall->deferFunction = ptrFunction;
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+    glbTaskChanged = true;
+#endif
 
-            break;
-        case TASK_NOT_FOUND:
-        case TASK_RUNNING:
-        default:
-        	taskStatus = TASK_SCHEDULED;
-            break;
+    return true;
+}
+#endif
+#if (MINIRTOS_CFG_TRACE_SIZE > 0)
+/*****************************************************************************
+ * @brief Copy the recorded trace events of the calling core out of the ring.
+ *
+ * @details Meant for a low priority task which sends the events out, e.g. over
+ *   SWO/ITM or a UART. A batch starts with a MINIRTOS_TRACE_SYNC event whose object
+ *   is MINIRTOS_TRACE_SYNC_MAGIC, a reader which lost bytes finds the event boundaries
+ *   again on it. Dropped events are reported by a MINIRTOS_TRACE_LOST event.
+ *
+ * @param ptrEvents   Buffer receiving the events.
+ *
+ * @param maxEvents   Size of the buffer in events, at least 3.
+ *
+ * @return Number of events copied, 0 if nothing was recorded since the last read
+ *****************************************************************************/
+uint16_t minirtos_Trace_Read(Trace_Event_t *ptrEvents, uint16_t maxEvents)
+{
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+    uint16_t count = 0;
+    uint16_t first;
+    uint32_t head;
+    uint32_t tail;
+    uint32_t lost;
+
+    if ((glbInitialized == false) || (ptrEvents == NULL) || (maxEvents < 3))
+    {
+        return 0;
+    }
+
+    head = ptrCore->traceHead;
+    {
+        MINIRTOS_ENTER_CRITICAL();
+        tail = ptrCore->traceTail;
+        lost = ptrCore->traceLost;
+        ptrCore->traceLost = 0;
+        MINIRTOS_EXIT_CRITICAL();
+    }
+    if ((head == tail) && (lost == 0))
+    {
+        return 0;
     }
-    if (ptrTaskDescriptor != NULL)
-        {
-            if (gptrTaskFirst != NULL)
-            {
-                /* Initialize the work pointer with the scheduler pointer */
-                ptrNewTask = gptrTaskSchedule;
-                /*As we need to implement circular Task list for our scheduler pass the first task pointer
-                 * to newly added task to complete the circle*/
-                while (ptrNewTask->gptrTaskNext != gptrTaskFirst)
-                {
-                    /* Set the work pointer on the next task*/
-                	ptrNewTask = ptrNewTask->gptrTaskNext;
-                }
-                /* Replace the last task->next task pointer with new task at the end of the circular linked list*/
-                ptrNewTask->gptrTaskNext = ptrTaskDescriptor;
-                /* The new task is linked back at the first task*/
-                ptrTaskDescriptor->gptrTaskNext = gptrTaskFirst;
-            }
-            else
-            {
-                /* There is no task in the scheduler, this task become the First task in the circular linked list*/
-            	/* The gptrTaskFirst pointer is initialized with the New Task*/
-            	gptrTaskFirst = ptrTaskDescriptor;
-            	/* Initialize the scheduled task pointer at the first task*/
-            	gptrTaskSchedule = gptrTaskFirst;
-            	/* The next task is itself because there is just one task in the circular linked list*/
-                ptrTaskDescriptor->gptrTaskNext = ptrTaskDescriptor;
-            }
 
+    ptrEvents[count].eventData = ((uint32_t)MINIRTOS_TRACE_SYNC << MINIRTOS_TRACE_TYPE_SHIFT) | MINIRTOS_TRACE_SYNC_MAGIC;
+    count++;
+    if (lost != 0)
+    {
+        ptrEvents[count].eventData = ((uint32_t)MINIRTOS_TRACE_LOST << MINIRTOS_TRACE_TYPE_SHIFT) |
+                                     ((lost < MINIRTOS_TRACE_OBJECT_MASK) ? lost : MINIRTOS_TRACE_OBJECT_MASK);
+        count++;
+    }
+    first = count;
+    while ((head != tail) && (count < maxEvents))
+    {
+        ptrEvents[count] = ptrCore->traceEvents[head & (MINIRTOS_CFG_TRACE_SIZE - 1)];
+        head++;
+        count++;
+    }
+    /* The leading events take the time of the first recorded one, so time never goes back */
+    ptrEvents[0].timestamp = (count > first) ? ptrEvents[first].timestamp : MINIRTOS_TRACE_TIMESTAMP();
+    ptrEvents[first - 1U].timestamp = ptrEvents[0].timestamp;
 
-            /*Tasks with ONE SHOT or RUN NOW are planned immediately*/
-            if(taskStatus == TASK_RUN_NOW || taskStatus == TASK_ONE_SHOT_NOW)
-            {
-            	ptrTaskDescriptor->plannedTask = glbSysTicks;
-            }
-            else
-            {
-            	ptrTaskDescriptor->taskStatus = taskStatus;
-            	ptrTaskDescriptor->plannedTask = glbSysTicks + taskInterval;
-            }
+    /* The events have to be copied before the slots are given back */
+    __DMB();
+    ptrCore->traceHead = head;
 
-            // Set the period of the task
-            ptrTaskDescriptor->taskInterval = taskInterval;
-            // Set the task pointer on the task body
-            ptrTaskDescriptor->taskPointer = ptrUserTask;
+    return count;
+}
 
-            glbNumberOfTasks++;
+/*****************************************************************************
+ * @brief Record the entry of the running interrupt handler.
+ *
+ * @details To be called first in the handlers to be traced, the object of the
+ *   event is the exception number (IRQ number + 16).
+ *****************************************************************************/
+void minirtos_Trace_IsrEnter(void)
+{
+    MINIRTOS_TRACE(MINIRTOS_TRACE_ISR_ENTER, __get_IPSR());
+}
 
+/*****************************************************************************
+ * @brief Record the exit of the running interrupt handler.
+ *
+ * @details To be called last in the handlers which call minirtos_Trace_IsrEnter().
+ *****************************************************************************/
+void minirtos_Trace_IsrExit(void)
+{
+    MINIRTOS_TRACE(MINIRTOS_TRACE_ISR_EXIT, __get_IPSR());
+}
 
-            return true;
-        }
-    free(ptrNewTask);
-    return false;
+/*****************************************************************************
+ * @brief Record an application event.
+ *
+ * @details E.g. to mark a state or a measurement in the timeline.
+ *
+ * @param value   Value of the event, truncated to 24 bits.
+ *****************************************************************************/
+void minirtos_Trace_User(uint32_t value)
+{
+    MINIRTOS_TRACE(MINIRTOS_TRACE_USER, value);
 }
+#endif
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
 /*****************************************************************************
- * @brief Remove the task from the scheduler.
+ * @brief Set the execution budget of a task.
  *
- * @details This function is used to remove the task from the scheduler.
+ * @details A task with a budget is watched: exceeding the budget is counted and
+ *   reported to the budget hook, and the watchdog hook is only called once every
+ *   watched task completed a run within budget. A paused task which stays watched
+ *   therefore stops the watchdog kicks, set its budget to 0 first.
  *
- * @param Task_Descriptor_t Descriptor of the task to be removed.
+ * @param ptrTaskDescriptor   Descriptor of the task.
  *
- * @return Return true if all went well, false otherwise.
+ * @param taskBudget   Longest allowed run in ticks, 0 to stop watching the task.
  *
  * @return True or False
- *
- * @see @Task_Descriptor_t
  *****************************************************************************/
-bool minirtos_RemoveTask(Task_Descriptor_t *ptrUserTaskDescriptor)
+bool minirtos_SetTaskBudget(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskBudget)
 {
-	Task_Descriptor_t *ptrNewTask = (Task_Descriptor_t *)malloc(sizeof(Task_Descriptor_t));
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
 
-    if ((glbInitialized == false) || (glbNumberOfTasks == MAX_TASKS_NUMBER) || (ptrUserTaskDescriptor == NULL))
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || !minirtos_IsTaskLocal(ptrTaskDescriptor))
     {
-    	free(ptrNewTask);
         return false;
     }
-    /* Initialize the work pointer with the scheduler pointer */
-    ptrNewTask = gptrTaskFirst;
 
-    while (ptrNewTask->gptrTaskNext != ptrUserTaskDescriptor)
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTaskDescriptor->gptrTaskPrev == NULL)
     {
-        /* Set the work pointer on the next task */
-    	ptrNewTask = ptrNewTask->gptrTaskNext;
+    	/* Not in the scheduler */
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
     }
-
-    if (ptrNewTask->gptrTaskNext == gptrTaskFirst)
+    if ((ptrTaskDescriptor->taskBudget == 0) && (taskBudget != 0))
     {
-    	gptrTaskFirst = ptrNewTask->gptrTaskNext->gptrTaskNext;
+    	/* Newly watched, has to check in during the current round */
+    	ptrTaskDescriptor->checkInRound = (uint8_t)(ptrCore->checkInRound - 1);
+    	ptrCore->watchedTasks++;
     }
-    else
+    else if ((ptrTaskDescriptor->taskBudget != 0) && (taskBudget == 0))
     {
-    	ptrNewTask->gptrTaskNext = ptrUserTaskDescriptor->gptrTaskNext;
+    	if (ptrTaskDescriptor->checkInRound == ptrCore->checkInRound)
+    	{
+    		ptrCore->checkedIn--;
+    	}
+    	ptrCore->watchedTasks--;
     }
+    ptrTaskDescriptor->taskBudget = taskBudget;
+    MINIRTOS_EXIT_CRITICAL();
 
-    glbNumberOfTasks--;
-
-    free(ptrNewTask);
     return true;
 }
+
 /*****************************************************************************
- * @brief Pause the task in the scheduler.
+ * @brief Install the budget overrun hook.
  *
- * @details This function is used to pause the task on the scheduler.
+ * @details The hook runs in the SysTick interrupt while the faulty task is still
+ *   running, it can log the task, reset the system or leave it running.
  *
- * @param Task_Descriptor_t Descriptor of the task to be removed.
+ * @param ptrBudgetHook   Function called on an overrun, NULL to disable.
+ *****************************************************************************/
+void minirtos_SetBudgetHook(gptr_Budget_Hook ptrBudgetHook)
+{
+	gptrBudgetHook = ptrBudgetHook;
+}
+
+/*****************************************************************************
+ * @brief Install the watchdog hook.
  *
- * @return Return true if all went well, false otherwise.
+ * @param ptrWatchdogHook   Function kicking the hardware watchdog, NULL to disable.
+ *****************************************************************************/
+void minirtos_SetWatchdogHook(gptr_Watchdog_Hook ptrWatchdogHook)
+{
+	gptrWatchdogHook = ptrWatchdogHook;
+}
+
+/*****************************************************************************
+ * @brief Budget tick.
  *
- * @return True or False
+ * @details Checks how long the running task has been executing, the first tick
+ *   beyond its budget counts an overrun and calls the budget hook once per run.
  *
- * @see @Task_Descriptor_t
+ * @note To be called from the SysTick handler after incrementing glbSysTicks.
  *****************************************************************************/
-bool minirtos_PauseTask(Task_Descriptor_t *ptrTaskDescriptor)
+void minirtos_Budget_Tick(void)
 {
-    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL))
+    Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+    Task_Descriptor_t *ptrTask = ptrCore->gptrTaskRunning;
+
+    if ((ptrTask == NULL) || (ptrTask->taskBudget == 0) || ptrCore->budgetExceeded)
+    {
+        return;
+    }
+    if ((uint32_t)(minirtos_GetTicks() - ptrCore->runStart) > ptrTask->taskBudget)
+    {
+        ptrCore->budgetExceeded = true;
+        ptrTask->budgetOverruns++;
+        if (gptrBudgetHook != NULL)
+        {
+            gptrBudgetHook(ptrTask);
+        }
+    }
+}
+#endif
+#if (MINIRTOS_CFG_COROUTINES == 1)
+/*****************************************************************************
+ * @brief Plan the next dispatch of a task ticks from now.
+ *
+ * @details Called by a coroutine task from its own body: the next start planned
+ *   from the task interval is replaced, 0 runs the task again on the next scheduler
+ *   pass after the other due tasks. A paused task stays paused.
+ *
+ * @param ptrTaskDescriptor   Descriptor of the task.
+ *
+ * @param ticks   Time until the next dispatch.
+ *
+ * @return True or False
+ *****************************************************************************/
+bool minirtos_Co_Delay(Task_Descriptor_t *ptrTaskDescriptor, uint32_t ticks)
+{
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || !minirtos_IsTaskLocal(ptrTaskDescriptor))
     {
         return false;
     }
 
-    ptrTaskDescriptor->taskStatus = TASK_PAUSE;
+    MINIRTOS_ENTER_CRITICAL();
+    if (ptrTaskDescriptor->gptrTaskPrev == NULL)
+    {
+    	/* Not in the scheduler */
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
+    }
+    ptrTaskDescriptor->plannedTask = minirtos_GetTicks() + ticks;
+    minirtos_TaskChanged(ptrTaskDescriptor);
+    MINIRTOS_EXIT_CRITICAL();
 
     return true;
 }
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
 /*****************************************************************************
- * @brief Resume the task in the scheduler.
+ * @brief One attempt of a blocking coroutine send.
  *
- * @details This function is used to restart a task that has been paused.
+ * @details Used by MINIRTOS_CO_SEND(): on a full queue the task is parked and not
+ *   dispatched until a receive frees a slot or its timeout elapses.
  *
- * @param Task_Descriptor_t Descriptor of the task to be removed.
+ * @param ptrTaskDescriptor   Descriptor of the calling task.
  *
- * @return Return true if all went well, false otherwise.
+ * @param ptrq      Descriptor of the queue.
  *
- * @return True or False
+ * @param ptrmsg    User message in the given queue.
  *
- * @see @Task_Descriptor_t
+ * @param timeout   Ticks from the start of the call, MINIRTOS_WAIT_FOREVER for no limit.
+ *
+ * @return QUEUE_WAIT_DONE, QUEUE_WAIT_TIMEOUT or QUEUE_WAIT_PARKED
  *****************************************************************************/
-bool minirtos_ResumeTask(Task_Descriptor_t *ptrTaskDescriptor)
+Queue_Wait_e minirtos_Co_Send(Task_Descriptor_t *ptrTaskDescriptor, Queue_Descriptor_t *ptrq,
+                              const void *ptrmsg, uint32_t timeout)
 {
-    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL))
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || (ptrq == NULL))
     {
-        return false;
+        return QUEUE_WAIT_TIMEOUT;
     }
 
-    ptrTaskDescriptor->taskStatus = TASK_SCHEDULED;
+    return minirtos_Co_Wait(ptrTaskDescriptor, ptrq, (void *)ptrmsg, true, timeout);
+}
 
-    ptrTaskDescriptor->plannedTask = glbSysTicks + ptrTaskDescriptor->taskInterval;
+/*****************************************************************************
+ * @brief One attempt of a blocking coroutine receive.
+ *
+ * @details Used by MINIRTOS_CO_RECEIVE(), same rules as minirtos_Co_Send().
+ *
+ * @param ptrTaskDescriptor   Descriptor of the calling task.
+ *
+ * @param ptrq      Descriptor of the queue.
+ *
+ * @param ptrmsg    User message removed from queue.
+ *
+ * @param timeout   Ticks from the start of the call, MINIRTOS_WAIT_FOREVER for no limit.
+ *
+ * @return QUEUE_WAIT_DONE, QUEUE_WAIT_TIMEOUT or QUEUE_WAIT_PARKED
+ *****************************************************************************/
+Queue_Wait_e minirtos_Co_Receive(Task_Descriptor_t *ptrTaskDescriptor, Queue_Descriptor_t *ptrq,
+                                 void *ptrmsg, uint32_t timeout)
+{
+    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL) || (ptrq == NULL))
+    {
+        return QUEUE_WAIT_TIMEOUT;
+    }
 
-    return true;
+    return minirtos_Co_Wait(ptrTaskDescriptor, ptrq, ptrmsg, false, timeout);
 }
+#endif
+
+#endif
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
 /*****************************************************************************
- * @brief Modify the task in the scheduler.
+ * @brief Create a preemptive thread.
  *
- * @details This function is used to modify a task parameters.
+ * @details Builds the initial context of the thread at the top of its stack, as
+ *   if it had been switched out just before its first instruction, and makes it
+ *   ready. If it is the highest ready thread it runs as soon as the caller leaves
+ *   its critical sections, also when called from main() before the scheduler.
  *
- * @param ptrTaskDescriptor   Descriptor of the task.
+ * @param ptrThread      Descriptor of the thread.
  *
- * @param ptrUserTask         Function pointer on the task body
+ * @param ptrUserThread  Thread function, normally never returns.
  *
- * @param taskInterval Scheduled interval in milliseconds at which you want your
- *                     routine to be executed.
+ * @param ptrStack       Statically allocated stack of the thread.
  *
- * @param taskStatus Status of the task to be added to the scheduler, status can
- *                   be:
- *                   PAUSE, for a task that doesn't have to start immediately;
- *                   SCHEDULED, for a normal task that has to start after its scheduling;
- *                   ONE_SHOT, for a task that has to run only once;
- *                   RUN_NOW, for a task that has to be executed once it
- *                   has been added to the scheduler;
- *                   ONE_SHOT_NOW, for a task that as to be executed now and it will only be
- *                   executed one time.
+ * @param stackWords     Size of the stack in 32 bit words, at least MINIRTOS_THREAD_MIN_STACK.
  *
- * @return True or False
+ * @param threadPriority Unique priority of the thread, 0 is the highest.
  *
- * @see @Task_Status_e, @Task_Descriptor_t
+ * @return True or False (priority already used, stack too small)
  *****************************************************************************/
-bool minirtos_ModifyTask(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskInterval, Task_Status_e taskStatus)
+bool minirtos_Thread_Create(Thread_Descriptor_t *ptrThread, gptr_Task_Function ptrUserThread,
+                            uint32_t *ptrStack, uint32_t stackWords, uint8_t threadPriority)
 {
-    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL))
+    uint32_t *ptrFrame;
+
+    if ((glbInitialized == false) || (ptrThread == NULL) || (ptrUserThread == NULL) || (ptrStack == NULL) ||
+        (stackWords < MINIRTOS_THREAD_MIN_STACK) || (threadPriority >= MINIRTOS_THREAD_PRIORITIES))
     {
         return false;
     }
 
-    if (taskStatus > TASK_ONE_SHOT_NOW)
+    /* The exception frame has to be 8 byte aligned */
+    ptrFrame = (uint32_t *)(((uintptr_t)&ptrStack[stackWords]) & ~(uintptr_t)7);
+
+    /* Hardware frame, popped by the exception return */
+    *(--ptrFrame) = 0x01000000UL;                       /* xPSR, Thumb state */
+    *(--ptrFrame) = (uint32_t)(uintptr_t)ptrUserThread; /* PC */
+    *(--ptrFrame) = (uint32_t)(uintptr_t)minirtos_Thread_Exit; /* LR */
+    for (uint8_t index = 0; index < 5; index++)
     {
-        return false;
+        *(--ptrFrame) = 0;                              /* R12, R3 - R0 */
+    }
+    /* Software frame, popped by PendSV_Handler() */
+    *(--ptrFrame) = 0xFFFFFFFDUL;                       /* EXC_RETURN, thread mode on PSP, no FPU context */
+    for (uint8_t index = 0; index < 9; index++)
+    {
+        *(--ptrFrame) = 0;                              /* R11 - R4, R3 as padding */
     }
 
-    ptrTaskDescriptor->taskInterval = taskInterval;
-    ptrTaskDescriptor->taskStatus = taskStatus;
+    MINIRTOS_ENTER_CRITICAL();
+    if (gptrThreadTable[threadPriority] != NULL)
+    {
+    	MINIRTOS_EXIT_CRITICAL();
+    	return false;
+    }
+    /* The switch must only run once every interrupt returned */
+    MINIRTOS_SCB_SHPR3 |= MINIRTOS_SHPR3_PENDSV_LOWEST;
 
-    if (taskStatus == TASK_SCHEDULED || taskStatus == TASK_ONE_SHOT)
+    ptrThread->stackPointer = ptrFrame;
+    ptrThread->threadPointer = ptrUserThread;
+    ptrThread->threadNotify = 0;
+    ptrThread->threadPriority = threadPriority;
+    ptrThread->threadStatus = THREAD_READY;
+    gptrThreadTable[threadPriority] = ptrThread;
+    glbThreadReady |= (0x80000000UL >> threadPriority);
+    minirtos_Thread_Reschedule();
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Put the running thread to sleep for a number of ticks.
+ *
+ * @details Lower priority threads and the cooperative tasks run meanwhile.
+ *   Does nothing out of a thread (cooperative task or interrupt).
+ *
+ * @param ticks   Sleep time, 0 returns at once.
+ *****************************************************************************/
+void minirtos_Thread_Delay(uint32_t ticks)
+{
+    if ((gptrThreadCurrent == NULL) || (__get_IPSR() != 0) || (ticks == 0))
     {
-    	ptrTaskDescriptor->plannedTask = glbSysTicks + taskInterval;
+        return;
     }
-    else
+
+    minirtos_Thread_Block(gptrThreadCurrent, THREAD_DELAYED, minirtos_GetTicks() + ticks);
+}
+
+/*****************************************************************************
+ * @brief Block the running thread until it is notified.
+ *
+ * @details Notifications are counted, each call takes one. Returns at once if one
+ *   is already pending. Does nothing out of a thread (cooperative task or interrupt).
+ *****************************************************************************/
+void minirtos_Thread_Wait(void)
+{
+    Thread_Descriptor_t *ptrThread = gptrThreadCurrent;
+
+    if ((ptrThread == NULL) || (__get_IPSR() != 0))
     {
-    	ptrTaskDescriptor->plannedTask = 0;
+        return;
     }
 
-    return true;
+    minirtos_Thread_Block(ptrThread, THREAD_WAITING, 0);
+
+    /* Only made ready again by a notification */
+    MINIRTOS_ENTER_CRITICAL();
+    ptrThread->threadNotify--;
+    MINIRTOS_EXIT_CRITICAL();
 }
+
 /*****************************************************************************
- * @brief Get status of the tasks.
+ * @brief Notify a thread.
  *
- * @details Function to check if a task is running or paused etc.
+ * @details Can be called from interrupts, threads and cooperative tasks. A waiting
+ *   thread becomes ready and preempts the caller if it has a higher priority.
  *
- * @param Task_Descriptor_t Descriptor of the task to be removed.
+ * @param ptrThread   Descriptor of the thread.
  *
- * @return taskStatus Status of the task to be added to the scheduler, status can
- *                   be:
- *                   PAUSE, for a task that doesn't have to start immediately;
- *                   SCHEDULED, for a normal task that has to start after its scheduling;
- *                   ONE_SHOT, for a task that has to run only once;
- *                   RUN_NOW, for a task that has to be executed once it
- *                   has been added to the scheduler;
- *                   ONE_SHOT_NOW, for a task that as to be executed now and it will only be
- *                   executed one time.
+ * @return True or False (thread not created)
+ *****************************************************************************/
+bool minirtos_Thread_Notify(Thread_Descriptor_t *ptrThread)
+{
+    if ((ptrThread == NULL) || (ptrThread->threadStatus == THREAD_DORMANT))
+    {
+        return false;
+    }
+
+    MINIRTOS_ENTER_CRITICAL();
+    ptrThread->threadNotify++;
+    if (ptrThread->threadStatus == THREAD_WAITING)
+    {
+        ptrThread->threadStatus = THREAD_READY;
+        glbThreadReady |= (0x80000000UL >> ptrThread->threadPriority);
+        minirtos_Thread_Reschedule();
+    }
+    MINIRTOS_EXIT_CRITICAL();
+
+    return true;
+}
+
+/*****************************************************************************
+ * @brief Thread tick.
  *
- * @see @Task_Descriptor_t
+ * @details Wakes the delayed threads whose wake tick is reached, a woken thread
+ *   with a higher priority than the running one preempts it when the SysTick
+ *   handler returns.
+ *
+ * @note To be called from the SysTick handler after incrementing glbSysTicks.
  *****************************************************************************/
-Task_Status_e minirtos_GetTaskStatus(Task_Descriptor_t *ptrTaskDescriptor)
+void minirtos_Thread_Tick(void)
 {
-    if ((glbInitialized == false) || (ptrTaskDescriptor == NULL))
+    minirtos_Tick_t sysTicks = minirtos_GetTicks();
+
+    MINIRTOS_ENTER_CRITICAL();
+    uint32_t delayed = glbThreadDelayed;
+
+    while (delayed != 0)
     {
-        return TASK_NOT_FOUND;
+        uint8_t priority = (uint8_t)MINIRTOS_CLZ(delayed);
+        uint32_t threadBit = (0x80000000UL >> priority);
+        Thread_Descriptor_t *ptrThread = gptrThreadTable[priority];
+
+        delayed &= ~threadBit;
+        if ((minirtos_TickDiff_t)(ptrThread->wakeTick - sysTicks) <= ZERO)
+        {
+            ptrThread->threadStatus = THREAD_READY;
+            glbThreadDelayed &= ~threadBit;
+            glbThreadReady |= threadBit;
+        }
     }
+    minirtos_Thread_Reschedule();
+    MINIRTOS_EXIT_CRITICAL();
+}
+
+/*****************************************************************************
+ * @brief Get the running thread.
+ *
+ * @return Descriptor of the running thread, NULL in the cooperative context.
+ *****************************************************************************/
+Thread_Descriptor_t *minirtos_Thread_Self(void)
+{
+    return gptrThreadCurrent;
+}
+
+/*****************************************************************************
+ * @brief PendSV exception handler doing the context switch.
+ *
+ * @details The cooperative context (main() and minirtos_Scheduler()) keeps running
+ *   on MSP, threads run on PSP. The callee saved registers (R4-R11, the FPU ones
+ *   S16-S31 if the context used the FPU) and EXC_RETURN are pushed on the stack of
+ *   the context being left, minirtos_Thread_Switch() stores its stack pointer and
+ *   returns the one of the next context, which is popped the same way. While the
+ *   cooperative context is switched out its registers stay at the top of MSP, the
+ *   interrupts keep nesting below them.
+ *
+ * @note PendSV has the lowest priority, so it never interrupts another handler.
+ *****************************************************************************/
+__attribute__((naked)) void PendSV_Handler(void)
+{
+    __asm volatile
+    (
+        "   cpsid   i                   \n"
+        "   tst     lr, #4              \n" /* Stack of the context being left */
+        "   ite     eq                  \n"
+        "   mrseq   r0, msp             \n"
+        "   mrsne   r0, psp             \n"
+#if defined(__ARM_FP)
+        "   tst     lr, #0x10           \n" /* FPU context in use */
+        "   it      eq                  \n"
+        "   vstmdbeq r0!, {s16-s31}     \n"
+#endif
+        "   stmdb   r0!, {r3-r11, lr}   \n" /* R3 keeps the frame 8 byte aligned */
+        "   tst     lr, #4              \n"
+        "   it      eq                  \n"
+        "   msreq   msp, r0             \n" /* Park the cooperative context on MSP */
+        "   bl      minirtos_Thread_Switch \n"
+        "   ldmia   r0!, {r3-r11, lr}   \n"
+#if defined(__ARM_FP)
+        "   tst     lr, #0x10           \n"
+        "   it      eq                  \n"
+        "   vldmiaeq r0!, {s16-s31}     \n"
+#endif
+        "   tst     lr, #4              \n" /* Stack of the context being restored */
+        "   ite     eq                  \n"
+        "   msreq   msp, r0             \n"
+        "   msrne   psp, r0             \n"
+        "   cpsie   i                   \n"
+        "   bx      lr                  \n"
+    );
+}
+#endif
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+/*****************************************************************************
+ * @brief Install the idle hook.
+ *
+ * @details The hook is called each time the scheduler has nothing to run, before it goes to sleep.
+ *
+ * @param ptrIdleHook   Function called when idle, NULL to disable.
+ *
+ * @return  None
+ *****************************************************************************/
+void minirtos_SetIdleHook(gptr_Idle_Hook ptrIdleHook)
+{
+	gptrIdleHook = ptrIdleHook;
+}
+
+/*****************************************************************************
+ * @brief Install the tickless sleep hook.
+ *
+ * @details Replaces the default SysTick based sleep, e.g. by a low-power timer
+ *   that keeps running in deep sleep modes.
+ *
+ * @param ptrSleepHook  Function suppressing the tick while idle, NULL to only
+ *                      execute WFI and wake up on every tick.
+ *
+ * @return  None
+ *****************************************************************************/
+void minirtos_SetSleepHook(gptr_Sleep_Hook ptrSleepHook)
+{
+	gptrSleepHook = ptrSleepHook;
+}
+
+/*****************************************************************************
+ * @brief Default tickless sleep hook based on SysTick.
+ *
+ * @details Stretches the SysTick period over the idle time, executes WFI and
+ *   returns the number of complete ticks spent sleeping. The SysTick reload value
+ *   configured by the application is taken as the length of one tick.
+ *
+ * @param expectedTicks  Ticks until the earliest planned task.
+ *
+ * @return Number of ticks slept which have not been counted by the SysTick handler.
+ *
+ * @note Called with interrupts disabled. The fraction of the tick running when an
+ *       early wake-up occurs is lost, so the time base may drift by up to one tick
+ *       per early wake-up.
+ *****************************************************************************/
+uint32_t minirtos_SysTickSleep(uint32_t expectedTicks)
+{
+	uint32_t tickReload = MINIRTOS_SYSTICK_LOAD;
+	uint32_t tickCycles = tickReload + 1;
+	uint32_t maxTicks = MINIRTOS_SYSTICK_MAX_RELOAD / tickCycles;
+	uint32_t sleepReload;
+	uint32_t sleptTicks;
+	uint32_t ctrl;
+
+	if (expectedTicks > maxTicks)
+	{
+		expectedTicks = maxTicks;
+	}
 
-    return ptrTaskDescriptor->taskStatus;
+	/* Stop the counter, the cycles left in the current tick are part of the long period */
+	MINIRTOS_SYSTICK_CTRL &= ~MINIRTOS_SYSTICK_ENABLE;
+	sleepReload = MINIRTOS_SYSTICK_VAL + ((expectedTicks - 1) * tickCycles);
+	MINIRTOS_SYSTICK_LOAD = sleepReload;
+	MINIRTOS_SYSTICK_VAL = 0;
+	MINIRTOS_SYSTICK_CTRL |= MINIRTOS_SYSTICK_ENABLE;
+
+	__DSB();
+	__WFI();
+	__ISB();
+
+	/* Reading CTRL clears COUNTFLAG, keep the value to know who woke us up */
+	ctrl = MINIRTOS_SYSTICK_CTRL;
+	MINIRTOS_SYSTICK_CTRL = ctrl & ~MINIRTOS_SYSTICK_ENABLE;
+
+	if (ctrl & MINIRTOS_SYSTICK_COUNTFLAG)
+	{
+		/* The whole period elapsed, the pending SysTick interrupt counts the last tick */
+		sleptTicks = expectedTicks - 1;
+	}
+	else
+	{
+		/* Woken up early by another interrupt, count the complete ticks only */
+		sleptTicks = (sleepReload - MINIRTOS_SYSTICK_VAL) / tickCycles;
+	}
+
+	/* Back to the normal tick */
+	MINIRTOS_SYSTICK_LOAD = tickReload;
+	MINIRTOS_SYSTICK_VAL = 0;
+	MINIRTOS_SYSTICK_CTRL |= MINIRTOS_SYSTICK_ENABLE;
+
+	return sleptTicks;
 }
+#endif
 /*****************************************************************************
  * @brief Scheduler.
  *
@@ -519,38 +4975,107 @@ Task_Status_e minirtos_GetTaskStatus(Task_Descriptor_t *ptrTaskDescriptor)
  *****************************************************************************/
 void minirtos_Scheduler(void)
 {
+	Core_Descriptor_t *ptrCore = MINIRTOS_CORE();
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1) && (MINIRTOS_CFG_TIMER_LIST == 0) && (MINIRTOS_READY_LEVELS == 0) && \
+    (MINIRTOS_CFG_BATCH_DISPATCH == 0)
+	bool taskRan = false; /* A task ran during the current pass over the list */
+#endif
+
 	while (1)
 	   {
-	       if (gptrTaskSchedule != NULL && glbNumberOfTasks != 0)
+	       /* One tick snapshot per pass, consistent even with 64 bit ticks */
+	       ptrCore->passTicks = minirtos_GetTicks();
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE > 0)
+	       /* Interrupt work handed over to the scheduler comes before any task */
+	       minirtos_Defer_Service(ptrCore);
+#endif
+#if (MINIRTOS_CFG_CORES > 1)
+	       /* Link the tasks and deliver the events posted by the other cores */
+	       minirtos_Core_Receive(ptrCore);
+#endif
+#if (MINIRTOS_CFG_SW_TIMERS == 1)
+	       /* Fire the timers which expired since the last pass */
+	       minirtos_Timer_Service(ptrCore);
+#endif
+#if (MINIRTOS_READY_LEVELS > 0)
+	       /* Queue the due tasks, then run the next one of the highest priority */
+	       minirtos_Ready_Release(ptrCore);
+	       ptrCore->gptrTaskSchedule = minirtos_Ready_PopHighest(ptrCore);
+	       if (ptrCore->gptrTaskSchedule != NULL)
+	       {
+	           minirtos_RunTask(ptrCore, ptrCore->gptrTaskSchedule);
+	       }
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+	       else
+	       {
+	           minirtos_Idle();
+	       }
+#endif
+#elif (MINIRTOS_CFG_TIMER_LIST == 1)
+	       /* The root of the timer list is the task with the earliest plannedTask */
+	       if ((ptrCore->heapCount != 0) && minirtos_IsTaskDue(ptrCore->gptrTaskHeap[0], ptrCore->passTicks))
+	       {
+	           ptrCore->gptrTaskSchedule = ptrCore->gptrTaskHeap[0];
+	           minirtos_RunTask(ptrCore, ptrCore->gptrTaskSchedule);
+	       }
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+	       else
+	       {
+	           minirtos_Idle();
+	       }
+#endif
+#elif (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+	       /* Link the tasks due at this tick once, then run all of them */
+	       minirtos_Batch_Build(ptrCore);
+	       if (ptrCore->gptrBatchFirst != NULL)
+	       {
+	           minirtos_Batch_Run(ptrCore);
+	       }
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+	       else
+	       {
+	           minirtos_Idle();
+	       }
+#endif
+#else
+	       if (ptrCore->gptrTaskSchedule != NULL && ptrCore->numberOfTasks != 0)
 	       {
 	           /*the task is running*/
-	           if (gptrTaskSchedule->taskStatus > TASK_PAUSE)
+	           if (minirtos_IsTaskActive(ptrCore->gptrTaskSchedule))
 	           {
-	               /*this trick overrun the overflow of System ticks*/
-	        	   intmax_t elapsedTime = (gptrTaskSchedule->plannedTask - glbSysTicks);
-	               if (elapsedTime <= ZERO)
+	               if (minirtos_IsTaskDue(ptrCore->gptrTaskSchedule, ptrCore->passTicks))
 	               {
-	                   if (gptrTaskSchedule->taskStatus & TASK_ONE_SHOT)
-	                   {
-	                	   gptrTaskSchedule->taskPointer(); //call the task
-	                	   gptrTaskSchedule->taskStatus = TASK_PAUSE; //pause the task
-	                   }
-	                   else
-	                   {
-	                       /* let's schedule next start */
-	                	   gptrTaskSchedule->plannedTask = glbSysTicks + gptrTaskSchedule->taskInterval;
-	                	   /* call the task */
-	                	   gptrTaskSchedule->taskPointer();
-	                   }
+	                   minirtos_RunTask(ptrCore, ptrCore->gptrTaskSchedule);
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+	                   taskRan = true;
+#endif
 	               }
 	           }
 	           /* If no task are added, the pointer is null */
-	           if (gptrTaskSchedule != NULL)
+	           if (ptrCore->gptrTaskSchedule != NULL)
 	           {
 	               /* Set the scheduler pointer on the next task */
-	        	   gptrTaskSchedule = gptrTaskSchedule->gptrTaskNext;
+	        	   ptrCore->gptrTaskSchedule = ptrCore->gptrTaskSchedule->gptrTaskNext;
+	           }
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+	           /* A whole pass over the list without running anything, nothing is due */
+	           if (ptrCore->gptrTaskSchedule == ptrCore->gptrTaskFirst)
+	           {
+	               if (taskRan == false)
+	               {
+	                   minirtos_Idle();
+	               }
+	               taskRan = false;
 	           }
+#endif
+	       }
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+	       else
+	       {
+	           minirtos_Idle();
 	       }
+#endif
+#endif
 	   }
 }
 /************************************END*****************************************/
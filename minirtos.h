@@ -70,13 +70,18 @@ extern "C"
 #define DEFAULT_TASK_INTERVAL       100
 
 /**
- * @brief Default No of Queue elements
+ * @brief Maximum No of Queue elements
  *
- * @details Default no of queue elements in case user puts an odd value
+ * @details Queues are only limited by the 16 bit indexes, the buffer is sized by the user.
+ */
+#define MAX_NO_OF_QUEUE_ELEMENTS    65535U
+
+/**
+ * @brief Maximum No of elements of a lock-free queue
  *
- * @note currently set to 20 can be changed as per needs
+ * @details head and tail of a lock-free queue run over twice the queue size.
  */
-#define MAX_NO_OF_QUEUE_ELEMENTS    20
+#define MAX_NO_OF_SPSC_QUEUE_ELEMENTS   32768U
 
 /**
  * @brief Enter MiniRTOS queue critical section (disable interrupts, save state).
@@ -88,7 +93,7 @@ extern "C"
  * @warning
  *   Only use around minimal, fast code. Do not place long-latency code or blocking operations inside.
  */
-#define MINIRTOS_QUEUE_ENTER_CRITICAL()   uint32_t primask = __get_PRIMASK(); __set_PRIMASK(1)
+#define MINIRTOS_QUEUE_ENTER_CRITICAL()   uint32_t primask = __get_PRIMASK(); __set_PRIMASK(1); MINIRTOS_CORE_LOCK()
 
 /**
  * @brief Exit MiniRTOS queue critical section (restore prior interrupt state).
@@ -97,197 +102,1913 @@ extern "C"
  *   If interrupts were previously enabled, this re-enables them.
  *   Should always be called after MINIRTOS_QUEUE_ENTER_CRIT().
  */
-#define MINIRTOS_QUEUE_EXIT_CRITICAL()    __set_PRIMASK(primask)
-/*****************************************************************************/
-/* Private typedefs                                                          */
-/*****************************************************************************/
+#define MINIRTOS_QUEUE_EXIT_CRITICAL()    MINIRTOS_CORE_UNLOCK(); __set_PRIMASK(primask)
+
 /**
- * @brief Pointer for Task functions.
+ * @brief Queue flag for the lock-free single producer / single consumer mode.
  *
- * @details Function pointer on the task body.
+ * @details Set by minirtos_Queue_CreateSPSC(). head and tail then run over twice the
+ *   queue size and no count is kept, so send and receive never disable interrupts.
  */
-typedef void (*gptr_Task_Function)(void);
-/*****************************************************************************/
-/* Private Enums                                                             */
-/*****************************************************************************/
+#define MINIRTOS_QUEUE_FLAG_SPSC          (1U << 0)
+
 /**
- * @brief Enum for Task status.
+ * @brief Queue flag set when maxElements is a power of two, indexes are wrapped with a mask.
+ */
+#define MINIRTOS_QUEUE_FLAG_POW2_SIZE     (1U << 1)
+
+/**
+ * @brief Queue flag set when elementSize is a power of two, slot offsets use elementShift.
+ */
+#define MINIRTOS_QUEUE_FLAG_POW2_ELEMENT  (1U << 2)
+
+/**
+ * @brief Queue flag set while the tail slot is reserved by minirtos_Queue_Reserve().
+ */
+#define MINIRTOS_QUEUE_FLAG_RESERVED      (1U << 3)
+
+/**
+ * @brief Queue flag set while the head slot is held by minirtos_Queue_Peek().
+ */
+#define MINIRTOS_QUEUE_FLAG_PEEKED        (1U << 4)
+
+/**
+ * @brief Queue flag for the overwrite-oldest mode.
  *
- * @details Used to switch between different task states.
+ * @details Set by minirtos_Queue_CreateOverwrite(). A send on a full queue drops the
+ *   oldest element instead of failing, the queue keeps the latest maxElements.
  */
-typedef enum
-{
-    // For a task that doesn't have to start immediately.
-    TASK_PAUSE              = 0x00,
-    // For a normal task that has to start after its scheduling.
-    TASK_SCHEDULED          = 0x01,
-    // For a task that has to run only once.
-    TASK_ONE_SHOT           = 0x02,
-    // For a task that has to be executed once it has been added.
-    TASK_RUN_NOW            = 0x03,
-    // For the task to be executed one time as soon as it is added.
-    TASK_ONE_SHOT_NOW       = 0x05,
-	// for the task which is currently running
-	TASK_RUNNING            = 0x06,
-    // Error, task not found.
-    TASK_NOT_FOUND          = 0xFF
-} Task_Status_e;
-/*****************************************************************************/
-/* Private Structures                                                        */
-/*****************************************************************************/
+#define MINIRTOS_QUEUE_FLAG_OVERWRITE     (1U << 5)
+
 /**
- * @brief Queue object for MiniRTOS.
+ * @brief Queue flag for the broadcast mode.
  *
- * @details Keeps buffer information and internal state (head/tail/count).
+ * @details Set by minirtos_Queue_CreateBroadcast(). The queue overwrites the oldest
+ *   element and is only read through Queue_Reader_t cursors, minirtos_Queue_Receive(),
+ *   minirtos_Queue_ReceiveBlock() and minirtos_Queue_Peek() fail on it.
  */
-typedef struct {
-	/* Pointer to user-allocated queue memory. */
-    void *buffer;
-    /* Size (in bytes) of each element. */
-    uint16_t elementSize;
-    /* Maximum elements queue can hold. */
-    uint16_t maxElements;
-    /* Read index. */
-    uint16_t head;
-    /* Write index. */
-    uint16_t tail;
-    /* Number of elements currently in queue. */
-    uint16_t count;
-} Queue_Descriptor_t;
+#define MINIRTOS_QUEUE_FLAG_BROADCAST     (1U << 6)
 
 /**
- * @brief Structure for task description.
+ * @brief Enter MiniRTOS scheduler critical section (disable interrupts, save state).
  *
- * @details Task related flags, functions & details.
+ * @details Protects the task list against changes made from interrupt context.
+ *   Same rules as MINIRTOS_QUEUE_ENTER_CRITICAL(). The task lists belong to one
+ *   core, so unlike the queue critical section no lock between the cores is taken.
  */
-typedef struct _Task_Descriptor_t
-{
-    /*Used to store the pointers to user's tasks*/
-	gptr_Task_Function taskPointer;
-    /*Used to store the interval between each task's run*/
-    uint32_t taskInterval;
-    /*Used to store the next time a task will have to be executed*/
-    uint32_t plannedTask;
-    /*Used to store the status of the tasks*/
-    Task_Status_e taskStatus;
-    /*Pointer to the next task in the list.*/
-    struct _Task_Descriptor_t *gptrTaskNext;
-} Task_Descriptor_t;
-/*****************************************************************************/
-/* Private Variables                                                         */
-/*****************************************************************************/
+#define MINIRTOS_ENTER_CRITICAL()         uint32_t primask = __get_PRIMASK(); __set_PRIMASK(1)
 
-extern volatile uintmax_t glbSysTicks; /** System tick value that increments periodically **/
+/**
+ * @brief Exit MiniRTOS scheduler critical section (restore prior interrupt state).
+ */
+#define MINIRTOS_EXIT_CRITICAL()          __set_PRIMASK(primask)
 
-/*****************************************************************************/
-/* User Functions                                                            */
-/*****************************************************************************/
 /**
- * @brief Create/init a queue instance.
+ * @brief Size of the static task descriptor pool.
  *
- * @details Creates a new queue for application/user.
+ * @details Number of descriptors handed out by minirtos_TaskPool_Acquire(), so tasks
+ *   can be created at runtime without heap. Set to 0 to remove the pool.
  */
-bool minirtos_Queue_Create(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements);
+#ifndef MINIRTOS_CFG_TASK_POOL_SIZE
+#define MINIRTOS_CFG_TASK_POOL_SIZE 0
+#endif
+
+#if (MINIRTOS_CFG_TASK_POOL_SIZE > MAX_TASKS_NUMBER)
+#error "MINIRTOS_CFG_TASK_POOL_SIZE can not be bigger than MAX_TASKS_NUMBER"
+#endif
 
 /**
- * @brief Enqueue data into queue.
+ * @brief Timer-list scheduling mode.
  *
- * @details Copies an item (of size specified at queue creation) into the queue.
- *   This function can be safely called from both main code and interrupt context, as it enters a critical
- *   section (disables interrupts) to protect the internal data structure. Operation is quick and minimal for ISR safety.
+ * @details When set to 1 the active tasks are also kept in a binary min-heap ordered
+ *   by plannedTask. The scheduler only checks the root of the heap, so finding out
+ *   whether a task is due is O(1) and rescheduling a task is O(log n), independent
+ *   of the number of paused or not yet due tasks.
  *
+ * @note Set to 0 to keep the plain circular scan of the task list.
  */
-bool minirtos_Queue_Send(Queue_Descriptor_t *ptrq, const void *ptrmsg);
+#ifndef MINIRTOS_CFG_TIMER_LIST
+#define MINIRTOS_CFG_TIMER_LIST     0
+#endif
 
 /**
- * @brief Dequeue data from queue.
+ * @brief Heap index of a task which is not in the timer list.
+ */
+#define MINIRTOS_HEAP_INVALID       0xFF
+
+/**
+ * @brief Number of task priority levels.
  *
- * @details  Copies an item out of the queue into user memory. Can be safely called from both
- *   main code and interrupt context, as it disables interrupts during the operation to prevent data races.
+ * @details When set (1 to 32) every task has a priority, 0 being the highest. Due tasks
+ *   are queued in one ready ring per priority and a ready bitmap gives the highest
+ *   non-empty ring with a single CLZ, so a due high priority task only waits for the
+ *   task currently running. Tasks of the same priority are run round-robin.
  *
+ * @note Set to 0 to keep all tasks equal in the circular list.
  */
-bool minirtos_Queue_Receive(Queue_Descriptor_t *ptrq, void *ptrmsg);
+#ifndef MINIRTOS_CFG_PRIORITY_LEVELS
+#define MINIRTOS_CFG_PRIORITY_LEVELS        0
+#endif
+
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 32)
+#error "MINIRTOS_CFG_PRIORITY_LEVELS can not be bigger than 32"
+#endif
 
 /**
- * @brief Get number of items currently in queue.
+ * @brief Priority given to the tasks by minirtos_AddTask().
  *
- * @details No of elements available in the queue.
+ * @note Defaults to the lowest priority.
  */
-uint16_t minirtos_Queue_Count(Queue_Descriptor_t *ptrq);
+#ifndef MINIRTOS_CFG_DEFAULT_PRIORITY
+#define MINIRTOS_CFG_DEFAULT_PRIORITY       (MINIRTOS_CFG_PRIORITY_LEVELS - 1)
+#endif
 
 /**
- * @brief Flush (clear) all contents from the queue.
+ * @brief Earliest-deadline-first scheduling mode.
  *
- * @details Resets head, tail, and count so queue is empty.
- *   Protects structure with critical section for safe use from main/IRQ context.
+ * @details When set to 1 every task has a relative deadline (its interval by default)
+ *   and the due task with the nearest absolute deadline (release time + relative
+ *   deadline) always runs first. Tasks declaring a worst case execution time are
+ *   only admitted while the total utilization (WCET / interval) stays within 100%.
+ *
+ * @note Can not be combined with MINIRTOS_CFG_PRIORITY_LEVELS.
  */
-void minirtos_Queue_Flush(Queue_Descriptor_t *ptrq);
+#ifndef MINIRTOS_CFG_EDF
+#define MINIRTOS_CFG_EDF                    0
+#endif
+
+#if (MINIRTOS_CFG_EDF == 1) && (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+#error "MINIRTOS_CFG_EDF and MINIRTOS_CFG_PRIORITY_LEVELS are exclusive scheduling policies"
+#endif
 
 /**
- * @brief Entry function for the user to initiate scheduler.
+ * @brief Full utilization of the CPU for the EDF admission test, in parts per million.
+ */
+#define MINIRTOS_EDF_MAX_UTILIZATION        1000000UL
+
+/**
+ * @brief Number of ready rings, EDF keeps all due tasks in a single deadline ordered ring.
+ */
+#if (MINIRTOS_CFG_EDF == 1)
+#define MINIRTOS_READY_LEVELS               1
+#else
+#define MINIRTOS_READY_LEVELS               MINIRTOS_CFG_PRIORITY_LEVELS
+#endif
+
+/**
+ * @brief Count leading zeros, used for the ready bitmap lookup.
  *
- * @details This function as to be called before doing anything with the tasker. It
- * initiates the tasker subsystems. If this funtion is not called before doing
- * anything with the tasker all functions will return false.
+ * @details Single instruction on Cortex-M3 and above, CMSIS provides a software
+ *   version for Cortex-M0.
+ */
+#ifndef MINIRTOS_CLZ
+#define MINIRTOS_CLZ(value)                 __CLZ(value)
+#endif
+
+/**
+ * @brief Batch dispatch of the tasks due on the same tick.
  *
- * @note Should be called once from `main()` or before scheduler to start application.
+ * @details When set to 1 the round robin task list is no longer stepped one task per
+ *   scheduler pass. The list is scanned once on the tick its earliest task becomes
+ *   due, the due tasks are linked in a batch and then run back to back against the
+ *   same tick, so tasks sharing an interval stay grouped. Ticks on which nothing is
+ *   due cost a single compare.
+ *
+ * @note Deferred calls, software timers and mailboxes are serviced between batches.
+ *   The timer list and the ready rings already dispatch the due tasks without a
+ *   scan, so the option is for the plain list only.
  */
-void minirtos_Init(void);
+#ifndef MINIRTOS_CFG_BATCH_DISPATCH
+#define MINIRTOS_CFG_BATCH_DISPATCH 0
+#endif
+
+#if (MINIRTOS_CFG_BATCH_DISPATCH == 1) && ((MINIRTOS_CFG_TIMER_LIST == 1) || (MINIRTOS_READY_LEVELS > 0))
+#error "MINIRTOS_CFG_BATCH_DISPATCH only applies to the round robin list, not to MINIRTOS_CFG_TIMER_LIST or priorities"
+#endif
+
 /**
- * @brief Add the task in the scheduler.
+ * @brief Tickless idle mode.
+ *
+ * @details When set to 1 the scheduler stops spinning once no task is due: it calls
+ *   the idle hook, then hands the number of ticks until the earliest plannedTask to
+ *   the sleep hook, which suppresses the tick, executes WFI and reports how long it
+ *   slept so glbSysTicks can be corrected.
  *
- * @details Add a task into the circular linked list for the scheduler.
+ * @note Set to 0 on boards without a suitable timer to keep the busy loop.
  */
+#ifndef MINIRTOS_CFG_TICKLESS_IDLE
+#define MINIRTOS_CFG_TICKLESS_IDLE  0
+#endif
 
-bool minirtos_AddTask(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
-                    uint32_t taskInterval, Task_Status_e taskStatus);
 /**
- * @brief Remove the task from the scheduler.
+ * @brief Minimum idle time (in ticks) worth suppressing the tick for.
  *
- * @details This function is used to remove the task from the scheduler.
+ * @details Shorter idle periods only execute WFI and wake up on the next tick.
  */
+#ifndef MINIRTOS_CFG_TICKLESS_MIN_TICKS
+#define MINIRTOS_CFG_TICKLESS_MIN_TICKS     2
+#endif
 
-bool minirtos_RemoveTask(Task_Descriptor_t *ptrUserTaskDescriptor);
+/**
+ * @brief SysTick registers used by the default tickless sleep hook.
+ *
+ * @details SysTick sits at the same address on every Cortex-M core.
+ */
+#define MINIRTOS_SYSTICK_CTRL       (*(volatile uint32_t *)0xE000E010UL)
+#define MINIRTOS_SYSTICK_LOAD       (*(volatile uint32_t *)0xE000E014UL)
+#define MINIRTOS_SYSTICK_VAL        (*(volatile uint32_t *)0xE000E018UL)
+#define MINIRTOS_SYSTICK_ENABLE     (1UL << 0)
+#define MINIRTOS_SYSTICK_COUNTFLAG  (1UL << 16)
+#define MINIRTOS_SYSTICK_MAX_RELOAD 0x00FFFFFFUL
 
 /**
- * @brief Pause the task in the scheduler.
+ * @brief Per-task runtime statistics.
  *
- * @details This function is used to pause the task on the scheduler.
+ * @details When set to 1 every task records its run count, execution time (in CPU
+ *   cycles), dispatch latency and missed deadlines, read with minirtos_GetTaskStats().
+ *
+ * @note Set to 0 to remove the instrumentation and its RAM entirely.
  */
+#ifndef MINIRTOS_CFG_TASK_STATS
+#define MINIRTOS_CFG_TASK_STATS     0
+#endif
 
-bool minirtos_PauseTask(Task_Descriptor_t *ptrTaskDescriptor);
+/**
+ * @brief DWT cycle counter registers used by the task statistics.
+ *
+ * @details Available on Cortex-M3 and above, the DWT is started by minirtos_Init().
+ *   MINIRTOS_STATS_CYCLES() can be defined to another free running 32 bit counter
+ *   (e.g. a timer on Cortex-M0).
+ */
+#define MINIRTOS_DEMCR              (*(volatile uint32_t *)0xE000EDFCUL)
+#define MINIRTOS_DEMCR_TRCENA       (1UL << 24)
+#define MINIRTOS_DWT_CTRL           (*(volatile uint32_t *)0xE0001000UL)
+#define MINIRTOS_DWT_CYCCNT         (*(volatile uint32_t *)0xE0001004UL)
+#define MINIRTOS_DWT_CYCCNTENA      (1UL << 0)
+
+#ifndef MINIRTOS_STATS_CYCLES
+#define MINIRTOS_STATS_CYCLES()     (MINIRTOS_DWT_CYCCNT)
+#else
+/* The user counter is not the DWT, do not touch the DWT registers */
+#define MINIRTOS_STATS_NO_DWT
+#endif
 
 /**
- * @brief Resume the task in the scheduler.
+ * @brief Event-driven tasks.
  *
- * @details This function is used to restart a task that has been paused.
+ * @details When set to 1 tasks can be woken by events: minirtos_NotifyTask() (also
+ *   from an ISR) or a successful send on a queue bound with minirtos_Queue_BindTask()
+ *   makes the task due at once. TASK_EVENT tasks only run when notified.
+ *
+ * @note Set to 0 to remove the event fields from the descriptors.
  */
+#ifndef MINIRTOS_CFG_TASK_EVENTS
+#define MINIRTOS_CFG_TASK_EVENTS    0
+#endif
 
-bool minirtos_ResumeTask(Task_Descriptor_t *ptrTaskDescriptor);
+/**
+ * @brief Task context argument.
+ *
+ * @details When set to 1 a task added with minirtos_AddTaskContext() is called with
+ *   the context pointer stored in its descriptor, so one task body can serve several
+ *   instances (e.g. one handler for all the UARTs) instead of one copy per instance.
+ *
+ * @note Set to 0 to remove the context pointer from the descriptors.
+ */
+#ifndef MINIRTOS_CFG_TASK_CONTEXT
+#define MINIRTOS_CFG_TASK_CONTEXT   0
+#endif
 
 /**
- * @brief Modify the task in the scheduler.
+ * @brief Drift-free periodic scheduling.
  *
- * @details This function is used to modify a task parameters.
+ * @details When set to 1 periodic tasks are planned from their previous planned
+ *   start (plannedTask += taskInterval) instead of from the moment they ran, so the
+ *   dispatch latency does not add up and the task keeps its exact rate. What happens
+ *   when a whole period was missed is selected by MINIRTOS_CFG_OVERRUN_POLICY.
+ *
+ * @note Set to 0 to keep plannedTask = glbSysTicks + taskInterval.
  */
+#ifndef MINIRTOS_CFG_DRIFT_FREE
+#define MINIRTOS_CFG_DRIFT_FREE     0
+#endif
 
-bool minirtos_ModifyTask(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskInterval, Task_Status_e taskStatus);
+/**
+ * @brief Overrun policies of the drift-free mode.
+ *
+ * @details SKIP drops the missed periods and keeps the phase, RESYNC runs the task
+ *   once and plans the next run one interval later (new phase), CATCH_UP runs the
+ *   missed periods back to back, at most MINIRTOS_CFG_CATCH_UP_MAX times in a row,
+ *   then skips the rest.
+ */
+#define MINIRTOS_OVERRUN_SKIP       0
+#define MINIRTOS_OVERRUN_RESYNC     1
+#define MINIRTOS_OVERRUN_CATCH_UP   2
+
+#ifndef MINIRTOS_CFG_OVERRUN_POLICY
+#define MINIRTOS_CFG_OVERRUN_POLICY MINIRTOS_OVERRUN_SKIP
+#endif
 
 /**
- * @brief Get status of the tasks.
+ * @brief Maximum number of back to back catch up runs of a task.
+ */
+#ifndef MINIRTOS_CFG_CATCH_UP_MAX
+#define MINIRTOS_CFG_CATCH_UP_MAX   3
+#endif
+
+#if (MINIRTOS_CFG_CATCH_UP_MAX > 255)
+#error "MINIRTOS_CFG_CATCH_UP_MAX can not be bigger than 255"
+#endif
+
+/**
+ * @brief 64 bit system tick.
  *
- * @details Function to check if a task is running or paused etc.
+ * @details By default glbSysTicks and plannedTask are 32 bit, every read is a single
+ *   load and all the comparisons use the signed difference, so they stay right when
+ *   the tick wraps (after ~49 days at 1 kHz), as long as no task is planned more than
+ *   2^31 ticks ahead. When set to 1 both are 64 bit and never wrap in practice,
+ *   minirtos_GetTicks() gives a consistent snapshot of the tick.
+ */
+#ifndef MINIRTOS_CFG_TICK_64BIT
+#define MINIRTOS_CFG_TICK_64BIT     0
+#endif
+
+/**
+ * @brief High resolution timer tasks.
+ *
+ * @details When set to 1 short callbacks can be run every few microseconds from
+ *   the compare interrupt of a free running 32 bit hardware timer (e.g. TIM2 or TIM5
+ *   of an STM32 counting at 1 MHz), independent of glbSysTicks and minirtos_Scheduler.
+ *   The timer tasks are kept sorted by due time, the interrupt runs the due ones and
+ *   programs the compare register with the next due time.
+ *
+ * @note The application starts the timer, enables its compare interrupt and calls
+ *   minirtos_HrTimer_IRQHandler() from it after clearing the interrupt flag.
  */
+#ifndef MINIRTOS_CFG_HRTIMER
+#define MINIRTOS_CFG_HRTIMER        0
+#endif
 
-Task_Status_e minirtos_GetTaskStatus(Task_Descriptor_t *ptrTaskDescriptor);
+#if (MINIRTOS_CFG_HRTIMER == 1)
+/**
+ * @brief Counter and compare registers of the high resolution timer.
+ *
+ * @details Have to be defined by the application, e.g. TIM2->CNT and TIM2->CCR1, and
+ *   MINIRTOS_HRTIMER_PEND() e.g. NVIC_SetPendingIRQ(TIM2_IRQn), used when a timer task
+ *   is added with a due time which is already over.
+ */
+#if !defined(MINIRTOS_HRTIMER_CNT) || !defined(MINIRTOS_HRTIMER_CCR) || !defined(MINIRTOS_HRTIMER_PEND)
+#error "MINIRTOS_CFG_HRTIMER needs MINIRTOS_HRTIMER_CNT, MINIRTOS_HRTIMER_CCR and MINIRTOS_HRTIMER_PEND"
+#endif
+#endif
 
 /**
- * @brief Scheduler.
+ * @brief Software timers.
  *
- * @details Scheduling. This runs the kernel itself.
+ * @details When set to 1 timers with a callback can be started without a task
+ *   descriptor (timeouts, debounce, retransmits). They are kept in a hashed timing
+ *   wheel of MINIRTOS_CFG_TIMER_WHEEL_SIZE slots indexed by the expiry tick, so start,
+ *   stop and restart are O(1) whatever the number of timers. The scheduler fires the
+ *   expired timers of each tick in one batch, from the main loop.
  */
+#ifndef MINIRTOS_CFG_SW_TIMERS
+#define MINIRTOS_CFG_SW_TIMERS      0
+#endif
 
-void minirtos_Scheduler(void);
+/**
+ * @brief Number of slots of the timing wheel, a power of two.
+ *
+ * @details A slot is visited once per tick and holds the timers expiring in that
+ *   tick modulo the wheel size, more slots mean shorter slot lists.
+ */
+#ifndef MINIRTOS_CFG_TIMER_WHEEL_SIZE
+#define MINIRTOS_CFG_TIMER_WHEEL_SIZE   32
+#endif
+
+#if (MINIRTOS_CFG_TIMER_WHEEL_SIZE & (MINIRTOS_CFG_TIMER_WHEEL_SIZE - 1)) != 0
+#error "MINIRTOS_CFG_TIMER_WHEEL_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Size of the deferred call ring, a power of two, 0 to disable.
+ *
+ * @details Interrupt handlers post a function and its argument with minirtos_Defer()
+ *   and return, the scheduler calls all posted functions at the start of its next
+ *   pass, before any task. Posting only claims a slot of the ring, with an exclusive
+ *   access where the core has one (Cortex-M3 and above), no queue copy under PRIMASK.
+ */
+#ifndef MINIRTOS_CFG_DEFER_QUEUE_SIZE
+#define MINIRTOS_CFG_DEFER_QUEUE_SIZE   0
+#endif
+
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE & (MINIRTOS_CFG_DEFER_QUEUE_SIZE - 1)) != 0
+#error "MINIRTOS_CFG_DEFER_QUEUE_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Size of the trace ring in events, a power of two, 0 to disable.
+ *
+ * @details Task start/end, queue send/receive and the interrupts marked with
+ *   minirtos_Trace_IsrEnter() / minirtos_Trace_IsrExit() are recorded as 8 byte
+ *   events with a timestamp. A low priority task drains them with
+ *   minirtos_Trace_Read() and sends them out (SWO/ITM, UART), tools/trace_decode
+ *   turns the stream into a timeline. Events are dropped and counted while the ring
+ *   is full. With 0 the hooks compile out.
+ */
+#ifndef MINIRTOS_CFG_TRACE_SIZE
+#define MINIRTOS_CFG_TRACE_SIZE     0
+#endif
+
+#if (MINIRTOS_CFG_TRACE_SIZE & (MINIRTOS_CFG_TRACE_SIZE - 1)) != 0
+#error "MINIRTOS_CFG_TRACE_SIZE must be a power of two"
+#endif
+
+/**
+ * @brief Timestamp of the trace events, a free running 32 bit counter.
+ *
+ * @details The DWT cycle counter by default, see MINIRTOS_STATS_CYCLES().
+ */
+#ifndef MINIRTOS_TRACE_TIMESTAMP
+#define MINIRTOS_TRACE_TIMESTAMP()  MINIRTOS_STATS_CYCLES()
+#endif
+
+/**
+ * @brief Trace event fields: type in the top byte, object in the low 24 bits.
+ *
+ * @details The object of a task or queue event is the low 24 bits of the descriptor
+ *   address, unique within 16 MB of RAM and resolved with the map file.
+ */
+#define MINIRTOS_TRACE_TYPE_SHIFT   24U
+#define MINIRTOS_TRACE_OBJECT_MASK  0x00FFFFFFUL
+#define MINIRTOS_TRACE_SYNC_MAGIC   0x00A55A5AUL
+
+/**
+ * @brief Preemptive threads.
+ *
+ * @details When set to 1 threads with their own statically allocated stack can be
+ *   created next to the cooperative tasks. Each thread has a unique priority (0 is
+ *   the highest), the highest ready thread always runs and preempts lower ones, the
+ *   cooperative scheduler and its tasks only run when no thread is ready. Threads
+ *   become ready from minirtos_Thread_Tick() (SysTick) or minirtos_Thread_Notify()
+ *   (any context), the switch itself is done by PendSV_Handler().
+ *
+ * @note Cortex-M3 and above. The application calls minirtos_Thread_Tick() from its
+ *   SysTick handler after incrementing glbSysTicks.
+ */
+#ifndef MINIRTOS_CFG_PREEMPTIVE
+#define MINIRTOS_CFG_PREEMPTIVE     0
+#endif
+
+#if (MINIRTOS_CFG_PREEMPTIVE == 1) && (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+#error "MINIRTOS_CFG_PREEMPTIVE can not be combined with MINIRTOS_CFG_TICKLESS_IDLE, the sleep would delay the thread wakeups"
+#endif
+
+/**
+ * @brief Stackless coroutine tasks.
+ *
+ * @details When set to 1 a task body can be written as a protothread with the
+ *   MINIRTOS_CO_xxx macros: it yields, delays or waits and resumes at the same point
+ *   on its next dispatch. Only the resume point (2 bytes) is kept in the descriptor,
+ *   local variables do not survive a yield and have to be static.
+ */
+#ifndef MINIRTOS_CFG_COROUTINES
+#define MINIRTOS_CFG_COROUTINES     0
+#endif
+
+/**
+ * @brief Task execution budget and watchdog.
+ *
+ * @details When set to 1 a task can get an execution budget in ticks with
+ *   minirtos_SetTaskBudget(). minirtos_Budget_Tick(), called from the SysTick handler,
+ *   detects a task running longer than its budget, counts the overrun and calls the
+ *   budget hook. Every run which completes within budget checks the task in, once
+ *   all the tasks having a budget checked in the watchdog hook is called, so the
+ *   hardware watchdog is only kicked while every watched task keeps running.
+ */
+#ifndef MINIRTOS_CFG_TASK_BUDGET
+#define MINIRTOS_CFG_TASK_BUDGET    0
+#endif
+
+/**
+ * @brief Number of cores running a scheduler instance.
+ *
+ * @details Above 1 every core gets its own task list, timer list and ready rings, a
+ *   task runs on the core which added it or the one given to minirtos_AddTaskOnCore().
+ *   Tasks are added to and notified on another core through a lock-free mailbox per
+ *   pair of cores, the queues and the task pool are shared and their critical sections
+ *   also take the lock between the cores. The port has to define MINIRTOS_CORE_ID()
+ *   (e.g. SIO->CPUID on the RP2040), MINIRTOS_CORE_LOCK() / MINIRTOS_CORE_UNLOCK()
+ *   (a hardware spinlock or semaphore) and may define MINIRTOS_CORE_SIGNAL(core) to
+ *   wake the core a message has been posted to (e.g. a push in the inter-core FIFO).
+ */
+#ifndef MINIRTOS_CFG_CORES
+#define MINIRTOS_CFG_CORES          1
+#endif
+
+/**
+ * @brief Number of messages a core can post to another core before its mailbox is full.
+ */
+#ifndef MINIRTOS_CFG_CORE_MAILBOX
+#define MINIRTOS_CFG_CORE_MAILBOX   8
+#endif
+
+#if (MINIRTOS_CFG_CORES > 1)
+#if !defined(MINIRTOS_CORE_ID) || !defined(MINIRTOS_CORE_LOCK) || !defined(MINIRTOS_CORE_UNLOCK)
+#error "MINIRTOS_CFG_CORES needs MINIRTOS_CORE_ID(), MINIRTOS_CORE_LOCK() and MINIRTOS_CORE_UNLOCK()"
+#endif
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1) || (MINIRTOS_CFG_PREEMPTIVE == 1)
+#error "MINIRTOS_CFG_CORES is not supported with MINIRTOS_CFG_TICKLESS_IDLE or MINIRTOS_CFG_PREEMPTIVE"
+#endif
+#ifndef MINIRTOS_CORE_SIGNAL
+#define MINIRTOS_CORE_SIGNAL(core)  __SEV()
+#endif
+#else
+#define MINIRTOS_CORE_ID()          0U
+#define MINIRTOS_CORE_LOCK()        ((void)0)
+#define MINIRTOS_CORE_UNLOCK()      ((void)0)
+#endif
+
+/**
+ * @brief Blocking queue send and receive.
+ *
+ * @details When set to 1 a thread calling minirtos_Queue_SendWait() /
+ *   minirtos_Queue_ReceiveWait(), or a coroutine task using MINIRTOS_CO_SEND() /
+ *   MINIRTOS_CO_RECEIVE(), is parked on a full or empty queue until another context
+ *   frees a slot or sends an element, or until its timeout elapses. Each change
+ *   wakes the highest priority waiter only: a thread first, else the coroutine task
+ *   with the highest priority, oldest first.
+ *
+ * @note Needs MINIRTOS_CFG_PREEMPTIVE or MINIRTOS_CFG_COROUTINES, single core only.
+ */
+#ifndef MINIRTOS_CFG_QUEUE_BLOCKING
+#define MINIRTOS_CFG_QUEUE_BLOCKING 0
+#endif
+
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
+#if (MINIRTOS_CFG_PREEMPTIVE == 0) && (MINIRTOS_CFG_COROUTINES == 0)
+#error "MINIRTOS_CFG_QUEUE_BLOCKING needs MINIRTOS_CFG_PREEMPTIVE or MINIRTOS_CFG_COROUTINES to park the caller"
+#endif
+#if (MINIRTOS_CFG_CORES > 1)
+#error "MINIRTOS_CFG_QUEUE_BLOCKING is not supported with MINIRTOS_CFG_CORES"
+#endif
+#endif
+
+/**
+ * @brief Timeout of a blocking queue call which never gives up.
+ */
+#define MINIRTOS_WAIT_FOREVER       UINT32_MAX
+
+/**
+ * @brief Fixed-size block pools.
+ *
+ * @details When set to 1 minirtos_Pool_xxx() hand out blocks of one size from user
+ *   provided storage, in O(1) and from any context, so message payloads can be
+ *   passed through queues as pointers without heap. The pool keeps the peak number
+ *   of blocks in use to size it from a test run.
+ */
+#ifndef MINIRTOS_CFG_BLOCK_POOL
+#define MINIRTOS_CFG_BLOCK_POOL     0
+#endif
+
+/**
+ * @brief Detect every double free of a pool block.
+ *
+ * @details When set to 1 minirtos_Pool_Free() walks the free list and refuses a
+ *   block which is already on it. The free then takes O(free blocks) with the
+ *   interrupts disabled, meant for debug builds. Without it only freeing the last
+ *   freed block twice is caught.
+ */
+#ifndef MINIRTOS_CFG_POOL_CHECK
+#define MINIRTOS_CFG_POOL_CHECK     0
+#endif
+
+/**
+ * @brief Size of one block of a pool, blockSize rounded up to hold the free list link.
+ *
+ * @details The storage of a pool holds numberOfBlocks times this many bytes,
+ *   aligned for a pointer.
+ */
+#define MINIRTOS_POOL_BLOCK_SIZE(blockSize) \
+                                    ((((blockSize) + sizeof(void *) - 1U) / sizeof(void *)) * sizeof(void *))
+
+/**
+ * @brief Broadcast queues with several readers.
+ *
+ * @details When set to 1 minirtos_Queue_CreateBroadcast() creates a queue which keeps
+ *   the latest maxElements and any number of Queue_Reader_t cursors read it
+ *   independently, so the same data is not copied into one queue per consumer.
+ *   A reader which fell more than maxElements behind skips to the oldest element
+ *   and counts the lost ones. Each queue counts its sends in 32 bits.
+ */
+#ifndef MINIRTOS_CFG_QUEUE_BROADCAST
+#define MINIRTOS_CFG_QUEUE_BROADCAST    0
+#endif
+
+/**
+ * @brief Scheduler instance of the calling core.
+ */
+#define MINIRTOS_CORE()             (&glbCore[MINIRTOS_CORE_ID()])
+
+/**
+ * @brief Core mailbox message adding a task.
+ */
+#define MINIRTOS_CORE_MSG_ADD       0U
+
+/**
+ * @brief Core mailbox message notifying events to a task.
+ */
+#define MINIRTOS_CORE_MSG_NOTIFY    1U
+
+/**
+ * @brief Number of thread priorities, one thread per priority.
+ */
+#define MINIRTOS_THREAD_PRIORITIES  32
+
+/**
+ * @brief Smallest thread stack, in 32 bit words.
+ *
+ * @details The initial context takes 18 words, an FPU context 16 more.
+ */
+#define MINIRTOS_THREAD_MIN_STACK   64
+
+/**
+ * @brief System control registers used by the context switch.
+ */
+#define MINIRTOS_SCB_ICSR           (*(volatile uint32_t *)0xE000ED04UL)
+#define MINIRTOS_SCB_SHPR3          (*(volatile uint32_t *)0xE000ED20UL)
+#define MINIRTOS_ICSR_PENDSVSET     (1UL << 28)
+#define MINIRTOS_SHPR3_PENDSV_LOWEST (0xFFUL << 16)
+/*****************************************************************************/
+/* Private typedefs                                                          */
+/*****************************************************************************/
+/**
+ * @brief Type of the system tick.
+ *
+ * @details minirtos_TickDiff_t is used for the wrap-safe signed difference of two ticks.
+ */
+#if (MINIRTOS_CFG_TICK_64BIT == 1)
+typedef uint64_t minirtos_Tick_t;
+typedef int64_t minirtos_TickDiff_t;
+#else
+typedef uint32_t minirtos_Tick_t;
+typedef int32_t minirtos_TickDiff_t;
+#endif
+
+/**
+ * @brief Pointer for Task functions.
+ *
+ * @details Function pointer on the task body.
+ */
+typedef void (*gptr_Task_Function)(void);
+
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+/**
+ * @brief Pointer for Task functions taking a context.
+ *
+ * @details Function pointer on a task body shared by several task instances.
+ */
+typedef void (*gptr_Task_Context_Function)(void *ptrContext);
+#endif
+
+/**
+ * @brief Pointer for the idle hook.
+ *
+ * @details Called by the scheduler each time it finds no task to run.
+ */
+typedef void (*gptr_Idle_Hook)(void);
+
+/**
+ * @brief Pointer for the tickless sleep hook.
+ *
+ * @details Called with interrupts disabled. Has to sleep for at most expectedTicks
+ *   and return the number of ticks elapsed which were not counted in glbSysTicks.
+ */
+typedef uint32_t (*gptr_Sleep_Hook)(uint32_t expectedTicks);
+
+struct _Task_Descriptor_t;
+
+/**
+ * @brief Pointer for the budget overrun hook.
+ *
+ * @details Called from the SysTick interrupt with the task exceeding its budget.
+ */
+typedef void (*gptr_Budget_Hook)(struct _Task_Descriptor_t *ptrTask);
+
+/**
+ * @brief Pointer for the watchdog hook.
+ *
+ * @details Called each time every watched task checked in, has to kick the hardware watchdog.
+ */
+typedef void (*gptr_Watchdog_Hook)(void);
+/*****************************************************************************/
+/* Private Enums                                                             */
+/*****************************************************************************/
+/**
+ * @brief Enum for Task status.
+ *
+ * @details Used to switch between different task states.
+ */
+typedef enum
+{
+    // For a task that doesn't have to start immediately.
+    TASK_PAUSE              = 0x00,
+    // For a normal task that has to start after its scheduling.
+    TASK_SCHEDULED          = 0x01,
+    // For a task that has to run only once.
+    TASK_ONE_SHOT           = 0x02,
+    // For a task that has to be executed once it has been added.
+    TASK_RUN_NOW            = 0x03,
+    // For a task that only runs when notified (MINIRTOS_CFG_TASK_EVENTS).
+    TASK_EVENT              = 0x04,
+    // For the task to be executed one time as soon as it is added.
+    TASK_ONE_SHOT_NOW       = 0x05,
+	// for the task which is currently running
+	TASK_RUNNING            = 0x06,
+    // Error, task not found.
+    TASK_NOT_FOUND          = 0xFF
+} Task_Status_e;
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+/**
+ * @brief Enum for thread status.
+ */
+typedef enum
+{
+    // Not created or returned from its function.
+    THREAD_DORMANT          = 0x00,
+    // Ready to run, or running.
+    THREAD_READY            = 0x01,
+    // Sleeping in minirtos_Thread_Delay().
+    THREAD_DELAYED          = 0x02,
+    // Blocked in minirtos_Thread_Wait().
+    THREAD_WAITING          = 0x03,
+    // Blocked on a queue without timeout, a timed wait is THREAD_DELAYED.
+    THREAD_PENDING          = 0x04
+} Thread_Status_e;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
+/**
+ * @brief Enum for the result of a blocking queue call.
+ */
+typedef enum
+{
+    // The element has been sent or received.
+    QUEUE_WAIT_DONE         = 0x00,
+    // The timeout elapsed before the queue changed.
+    QUEUE_WAIT_TIMEOUT      = 0x01,
+    // The coroutine task is parked on the queue and has to return.
+    QUEUE_WAIT_PARKED       = 0x02
+} Queue_Wait_e;
+#endif
+/*****************************************************************************/
+/* Private Structures                                                        */
+/*****************************************************************************/
+struct _Task_Descriptor_t;
+
+/**
+ * @brief Queue object for MiniRTOS.
+ *
+ * @details Keeps buffer information and internal state (head/tail/count).
+ */
+typedef struct {
+	/* Pointer to user-allocated queue memory. */
+    void *buffer;
+    /* Size (in bytes) of each element. */
+    uint16_t elementSize;
+    /* Maximum elements queue can hold. */
+    uint16_t maxElements;
+    /* Read index. */
+    uint16_t head;
+    /* Write index. */
+    uint16_t tail;
+    /* Number of elements currently in queue. */
+    uint16_t count;
+    /* Operating mode of the queue (MINIRTOS_QUEUE_FLAG_xxx). */
+    uint8_t flags;
+    /* log2(elementSize) when elementSize is a power of two. */
+    uint8_t elementShift;
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    /* Task notified on each successful send, NULL for none. */
+    struct _Task_Descriptor_t *ptrTaskWake;
+    /* Events given to ptrTaskWake. */
+    uint32_t wakeEvents;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+    /* Threads waiting for a free slot, bit (31 - priority) per thread. */
+    volatile uint32_t threadSendWait;
+    /* Threads waiting for an element. */
+    volatile uint32_t threadReceiveWait;
+#endif
+#if (MINIRTOS_CFG_COROUTINES == 1)
+    /* Coroutine tasks waiting for a free slot, highest priority first. */
+    struct _Task_Descriptor_t *ptrTaskSendWait;
+    /* Coroutine tasks waiting for an element. */
+    struct _Task_Descriptor_t *ptrTaskReceiveWait;
+#endif
+#endif
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+    /* Number of elements ever sent, wraps. */
+    uint32_t sequence;
+#endif
+} Queue_Descriptor_t;
+
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+/**
+ * @brief Read cursor of one consumer of a broadcast queue.
+ *
+ * @details Several readers attached to the same queue see every element, each at
+ *   its own pace, the queue does not know its readers.
+ */
+typedef struct {
+    /* Broadcast queue the reader is attached to. */
+    Queue_Descriptor_t *ptrq;
+    /* Queue sequence of the next element to read. */
+    uint32_t sequence;
+    /* Elements overwritten before the reader got them. */
+    uint32_t lost;
+} Queue_Reader_t;
+#endif
+
+#if (MINIRTOS_CFG_BLOCK_POOL == 1)
+/**
+ * @brief Fixed-size block pool for MiniRTOS.
+ *
+ * @details The free blocks are linked through their first word, a block in use
+ *   belongs entirely to its owner.
+ */
+typedef struct {
+    /* First free block, NULL when the pool is exhausted. */
+    void *ptrFree;
+    /* Pointer to user-allocated pool memory. */
+    uint8_t *buffer;
+    /* Size (in bytes) of each block, see MINIRTOS_POOL_BLOCK_SIZE(). */
+    uint16_t blockSize;
+    /* Number of blocks of the pool. */
+    uint16_t numberOfBlocks;
+    /* Number of blocks currently free. */
+    uint16_t freeBlocks;
+    /* Highest number of blocks in use at the same time. */
+    uint16_t peakBlocks;
+} Pool_Descriptor_t;
+#endif
+
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+/**
+ * @brief Runtime statistics of a task.
+ *
+ * @details Execution times are in CPU cycles, latencies in ticks.
+ */
+typedef struct {
+    /* Number of times the task body was called. */
+    uint32_t runCount;
+    /* Execution time of the last run. */
+    uint32_t lastCycles;
+    /* Shortest execution time. */
+    uint32_t minCycles;
+    /* Longest execution time. */
+    uint32_t maxCycles;
+    /* Sum of all the execution times. */
+    uint64_t totalCycles;
+    /* Start of the last run minus plannedTask. */
+    uint32_t lastLatency;
+    /* Biggest start latency. */
+    uint32_t maxLatency;
+    /* Runs which finished later than the deadline (the interval without EDF). */
+    uint32_t missedDeadlines;
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    /* Runs which exceeded the execution budget. */
+    uint32_t budgetOverruns;
+#endif
+} Task_Stats_t;
+#endif
+
+/**
+ * @brief Structure for task description.
+ *
+ * @details Task related flags, functions & details.
+ */
+typedef struct _Task_Descriptor_t
+{
+    /* Hot part, read on every scheduler step: kept together at the start of the
+     * descriptor so a step touches a single cache line. The byte fields follow
+     * each other so they share one word. */
+    /*Used to store the next time a task will have to be executed*/
+    minirtos_Tick_t plannedTask;
+    /*Pointer to the next task in the list.*/
+    struct _Task_Descriptor_t *gptrTaskNext;
+    /*Used to store the pointers to user's tasks*/
+	gptr_Task_Function taskPointer;
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+    /*Argument of a task body taking a context, NULL for a plain task body*/
+    void *taskContext;
+#endif
+    /*Used to store the interval between each task's run*/
+    uint32_t taskInterval;
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    /*Events notified and not yet handed to the task*/
+    volatile uint32_t taskEvents;
+#endif
+    /*Used to store the status of the tasks, a Task_Status_e*/
+    uint8_t taskStatus;
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+    /*Position of the task in the timer list, MINIRTOS_HEAP_INVALID when not in it*/
+    uint8_t heapIndex;
+#endif
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+    /*Priority of the task, 0 is the highest*/
+    uint8_t taskPriority;
+#endif
+#if (MINIRTOS_CFG_DRIFT_FREE == 1) && (MINIRTOS_CFG_OVERRUN_POLICY == MINIRTOS_OVERRUN_CATCH_UP)
+    /*Number of back to back catch up runs*/
+    uint8_t catchUpCount;
+#endif
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    /*Watchdog round in which the task last checked in*/
+    uint8_t checkInRound;
+#endif
+#if (MINIRTOS_CFG_CORES > 1)
+    /*Core whose scheduler instance runs the task*/
+    uint8_t taskCore;
+#endif
+    /* Cold part, only used when the task is changed or runs, widest fields first */
+#if (MINIRTOS_CFG_EDF == 1)
+    /*Deadline of the current release (planned start + relative deadline)*/
+    minirtos_Tick_t absoluteDeadline;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_COROUTINES == 1)
+    /*Tick at which the current blocking queue call started*/
+    minirtos_Tick_t waitStart;
+#endif
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+    /*Runtime statistics of the task*/
+    Task_Stats_t taskStats;
+#endif
+    /*Pointer to the previous task in the list, NULL when the task is not in the scheduler.*/
+    struct _Task_Descriptor_t *gptrTaskPrev;
+#if (MINIRTOS_READY_LEVELS > 0)
+    /*Links in the ready ring of the task priority, NULL when the task is not due*/
+    struct _Task_Descriptor_t *gptrReadyNext;
+    struct _Task_Descriptor_t *gptrReadyPrev;
+#endif
+#if (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+    /*Next task of the batch being dispatched*/
+    struct _Task_Descriptor_t *gptrBatchNext;
+#endif
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_COROUTINES == 1)
+    /*Queue the task is parked on, NULL when it is not waiting*/
+    Queue_Descriptor_t *ptrWaitQueue;
+    /*Next task parked on the same queue*/
+    struct _Task_Descriptor_t *gptrWaitNext;
+#endif
+#if (MINIRTOS_CFG_EDF == 1)
+    /*Deadline relative to the planned start of the task*/
+    uint32_t taskDeadline;
+    /*Declared worst case execution time, used by the admission test*/
+    uint32_t taskWcet;
+    /*Share of the CPU reserved for the task, in parts per million*/
+    uint32_t taskUtilization;
+#endif
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    /*Execution budget in ticks, 0 when the task is not watched*/
+    uint32_t taskBudget;
+    /*Number of runs which exceeded the budget*/
+    uint32_t budgetOverruns;
+#endif
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+    /*Events handed to the current run of the task*/
+    uint32_t runEvents;
+#endif
+#if (MINIRTOS_CFG_COROUTINES == 1)
+    /*Resume point of a coroutine task, 0 to start from the beginning*/
+    uint16_t coLine;
+#endif
+} Task_Descriptor_t;
+
+#if (MINIRTOS_CFG_SW_TIMERS == 1)
+struct _Timer_Descriptor_t;
+
+/**
+ * @brief Pointer for the callback of a software timer, called with the expired timer.
+ */
+typedef void (*gptr_Timer_Callback)(struct _Timer_Descriptor_t *ptrTimer);
+
+/**
+ * @brief Structure for software timer description.
+ *
+ * @details The callback gets the timer, so a timer embedded in a larger structure
+ *   finds its owner.
+ */
+typedef struct _Timer_Descriptor_t
+{
+    /*Tick at which the timer expires*/
+    minirtos_Tick_t expiryTick;
+    /*Next timer of the wheel slot*/
+    struct _Timer_Descriptor_t *gptrTimerNext;
+    /*Link pointing at this timer (slot head or next field of the previous timer), NULL when stopped*/
+    struct _Timer_Descriptor_t **gptrTimerLink;
+    /*Function called on expiry*/
+    gptr_Timer_Callback timerCallback;
+    /*Ticks from the start to the first expiry, used again by minirtos_Timer_Restart()*/
+    uint32_t timerTimeout;
+    /*Ticks between the following expiries, 0 for a one shot timer*/
+    uint32_t timerPeriod;
+} Timer_Descriptor_t;
+#endif
+
+#if (MINIRTOS_CFG_TRACE_SIZE > 0)
+/**
+ * @brief Trace event types.
+ */
+typedef enum
+{
+    // Start of a task run, object: task descriptor.
+    MINIRTOS_TRACE_TASK_START       = 0x01,
+    // End of a task run, object: task descriptor.
+    MINIRTOS_TRACE_TASK_END         = 0x02,
+    // Element or block queued, or slot committed, object: queue descriptor.
+    MINIRTOS_TRACE_QUEUE_SEND       = 0x03,
+    // Send or commit refused, object: queue descriptor.
+    MINIRTOS_TRACE_QUEUE_FULL       = 0x04,
+    // Element or block dequeued, or slot released, object: queue descriptor.
+    MINIRTOS_TRACE_QUEUE_RECEIVE    = 0x05,
+    // Receive or release refused, object: queue descriptor.
+    MINIRTOS_TRACE_QUEUE_EMPTY      = 0x06,
+    // Interrupt handler entry, object: exception number.
+    MINIRTOS_TRACE_ISR_ENTER        = 0x07,
+    // Interrupt handler exit, object: exception number.
+    MINIRTOS_TRACE_ISR_EXIT         = 0x08,
+    // Application event, object: value given to minirtos_Trace_User().
+    MINIRTOS_TRACE_USER             = 0x09,
+    // Events dropped while the ring was full, object: number of events.
+    MINIRTOS_TRACE_LOST             = 0xFE,
+    // Start of a batch, object: MINIRTOS_TRACE_SYNC_MAGIC.
+    MINIRTOS_TRACE_SYNC             = 0xFF
+} Trace_Event_e;
+
+/**
+ * @brief Trace event, 8 bytes sent as they are in memory (little endian).
+ */
+typedef struct {
+    /*MINIRTOS_TRACE_TIMESTAMP() when the event was recorded*/
+    uint32_t timestamp;
+    /*Trace_Event_e in the top byte, object in the low 24 bits*/
+    uint32_t eventData;
+} Trace_Event_t;
+#endif
+
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE > 0)
+/**
+ * @brief Pointer for a deferred function, called with the argument it was posted with.
+ */
+typedef void (*gptr_Defer_Function)(void *ptrArgument);
+
+/**
+ * @brief Slot of the deferred call ring.
+ */
+typedef struct {
+    /*Function to call, NULL while the slot is free or still being written*/
+    volatile gptr_Defer_Function deferFunction;
+    /*Argument of the function*/
+    void *ptrArgument;
+} Defer_Call_t;
+#endif
+
+#if (MINIRTOS_CFG_CORES > 1)
+/**
+ * @brief Message posted to the mailbox of another core.
+ */
+typedef struct {
+    /*Task the message is about*/
+    Task_Descriptor_t *ptrTask;
+    /*Events of a MINIRTOS_CORE_MSG_NOTIFY message*/
+    uint32_t taskEvents;
+    /*MINIRTOS_CORE_MSG_ADD or MINIRTOS_CORE_MSG_NOTIFY*/
+    uint8_t messageType;
+} Core_Message_t;
+#endif
+
+/**
+ * @brief Structure for the scheduler instance of a core.
+ *
+ * @details Holds everything the scheduler of one core works on, only that core
+ *   changes it. Other cores reach it through the mailboxes.
+ */
+typedef struct {
+    /*Number of tasks of the core*/
+    uint8_t numberOfTasks;
+    /*Pointer to the next task that is scheduled to run*/
+    Task_Descriptor_t *gptrTaskSchedule;
+    /*Pointer to the first task of the circular task list*/
+    Task_Descriptor_t *gptrTaskFirst;
+    /*Tick snapshot of the current scheduler pass*/
+    minirtos_Tick_t passTicks;
+#if (MINIRTOS_CFG_TIMER_LIST == 1)
+    /*Active tasks as a binary min-heap ordered by plannedTask*/
+    Task_Descriptor_t *gptrTaskHeap[MAX_TASKS_NUMBER];
+    /*Number of tasks currently in the timer list*/
+    uint8_t heapCount;
+#endif
+#if (MINIRTOS_READY_LEVELS > 0)
+    /*Next task to run of each priority*/
+    Task_Descriptor_t *gptrReadyFirst[MINIRTOS_READY_LEVELS];
+    /*Bit (31 - priority) is set while the ready ring of the priority is not empty*/
+    volatile uint32_t readyBitmap;
+#if (MINIRTOS_CFG_TIMER_LIST == 0)
+    /*Tick at which the task list has last been scanned for due tasks*/
+    minirtos_Tick_t releaseTick;
+#endif
+#endif
+#if (MINIRTOS_CFG_BATCH_DISPATCH == 1)
+    /*Tasks of the current batch which still have to run*/
+    Task_Descriptor_t *gptrBatchFirst;
+    /*No active task is due before this tick, the list is scanned again from it*/
+    volatile minirtos_Tick_t batchTick;
+#endif
+#if (MINIRTOS_CFG_EDF == 1)
+    /*Sum of the CPU shares of the admitted tasks, in parts per million*/
+    uint32_t utilization;
+#endif
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+    /*Task whose body is executing, NULL between tasks*/
+    Task_Descriptor_t * volatile gptrTaskRunning;
+    /*Tick at which the running task was started*/
+    minirtos_Tick_t runStart;
+    /*Set once the running task exceeded its budget*/
+    volatile bool budgetExceeded;
+    /*Number of tasks having a budget*/
+    uint8_t watchedTasks;
+    /*Number of watched tasks which checked in during the current round*/
+    uint8_t checkedIn;
+    /*Current watchdog round*/
+    uint8_t checkInRound;
+#endif
+#if (MINIRTOS_CFG_SW_TIMERS == 1)
+    /*Timing wheel, each slot lists the timers expiring in that tick modulo the wheel size*/
+    Timer_Descriptor_t *gptrTimerWheel[MINIRTOS_CFG_TIMER_WHEEL_SIZE];
+    /*Last tick whose wheel slot has been serviced*/
+    minirtos_Tick_t timerTick;
+#endif
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE > 0)
+    /*Ring of the calls deferred by the interrupt handlers*/
+    Defer_Call_t deferCalls[MINIRTOS_CFG_DEFER_QUEUE_SIZE];
+    /*Number of calls ever claimed, advanced by the interrupt handlers*/
+    volatile uint32_t deferTail;
+    /*Number of calls ever completed, advanced by the scheduler*/
+    volatile uint32_t deferHead;
+#endif
+#if (MINIRTOS_CFG_TRACE_SIZE > 0)
+    /*Trace events of the core, recorded by its tasks and interrupt handlers*/
+    Trace_Event_t traceEvents[MINIRTOS_CFG_TRACE_SIZE];
+    /*Number of events ever recorded*/
+    volatile uint32_t traceTail;
+    /*Number of events ever read*/
+    uint32_t traceHead;
+    /*Events dropped since the last read*/
+    uint32_t traceLost;
+#endif
+#if (MINIRTOS_CFG_CORES > 1)
+    /*Lock-free mailbox of each sending core*/
+    Queue_Descriptor_t coreMailbox[MINIRTOS_CFG_CORES];
+    /*Message buffers of the mailboxes*/
+    Core_Message_t coreMessages[MINIRTOS_CFG_CORES][MINIRTOS_CFG_CORE_MAILBOX];
+#endif
+} Core_Descriptor_t;
+
+#if (MINIRTOS_CFG_HRTIMER == 1)
+/**
+ * @brief Structure for high resolution timer task description.
+ *
+ * @details Timer tasks run in interrupt context, they must be short and may only
+ *   use interrupt safe calls (queues, minirtos_NotifyTask(), ...).
+ */
+typedef struct _HrTask_Descriptor_t
+{
+    /*Used to store the pointer to the user's callback*/
+    gptr_Task_Function taskPointer;
+    /*Interval between each run, in timer counts*/
+    uint32_t taskInterval;
+    /*Timer count of the next run*/
+    uint32_t plannedTask;
+    /*Next timer task in due time order, NULL for the last one*/
+    struct _HrTask_Descriptor_t *gptrTaskNext;
+    /*Set while the timer task is in the due list*/
+    bool taskActive;
+    /*Set while its callback runs and the handler has to put it back in the list*/
+    bool taskRunning;
+} HrTask_Descriptor_t;
+#endif
+
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+/**
+ * @brief Structure for preemptive thread description.
+ *
+ * @details Threads run forever in their own stack, they block with
+ *   minirtos_Thread_Delay() or minirtos_Thread_Wait().
+ */
+typedef struct _Thread_Descriptor_t
+{
+    /*Saved stack pointer while the thread is switched out*/
+    uint32_t *stackPointer;
+    /*Used to store the pointer to the thread function*/
+    gptr_Task_Function threadPointer;
+    /*Tick at which a delayed thread becomes ready*/
+    minirtos_Tick_t wakeTick;
+    /*Notifications not yet taken by minirtos_Thread_Wait()*/
+    volatile uint32_t threadNotify;
+    /*Used to store the status of the thread*/
+    volatile Thread_Status_e threadStatus;
+    /*Priority of the thread, 0 is the highest*/
+    uint8_t threadPriority;
+} Thread_Descriptor_t;
+#endif
+/*****************************************************************************/
+/* Private Variables                                                         */
+/*****************************************************************************/
+
+extern volatile minirtos_Tick_t glbSysTicks; /** System tick value that increments periodically, defined by the application **/
+
+/*****************************************************************************/
+/* User Functions                                                            */
+/*****************************************************************************/
+/**
+ * @brief Create/init a queue instance.
+ *
+ * @details Creates a new queue for application/user.
+ */
+bool minirtos_Queue_Create(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements);
+
+/**
+ * @brief Create/init a lock-free single producer / single consumer queue.
+ *
+ * @details Send and receive on this queue never disable interrupts. Exactly one
+ *   producer (e.g. an ISR) and one consumer (e.g. a task) may use it. It can not be
+ *   bound to a task and a blocking call on it polls once per tick.
+ */
+bool minirtos_Queue_CreateSPSC(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements);
+
+/**
+ * @brief Create/init a queue which overwrites its oldest element when full.
+ *
+ * @details Sends only fail while a slot is reserved or the oldest element is held
+ *   by minirtos_Queue_Peek(), the queue keeps the latest maxElements.
+ */
+bool minirtos_Queue_CreateOverwrite(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements);
+
+/**
+ * @brief Enqueue data into queue.
+ *
+ * @details Copies an item (of size specified at queue creation) into the queue.
+ *   This function can be safely called from both main code and interrupt context, as it enters a critical
+ *   section (disables interrupts) to protect the internal data structure. Operation is quick and minimal for ISR safety.
+ *
+ */
+bool minirtos_Queue_Send(Queue_Descriptor_t *ptrq, const void *ptrmsg);
+
+/**
+ * @brief Dequeue data from queue.
+ *
+ * @details  Copies an item out of the queue into user memory. Can be safely called from both
+ *   main code and interrupt context, as it disables interrupts during the operation to prevent data races.
+ *
+ */
+bool minirtos_Queue_Receive(Queue_Descriptor_t *ptrq, void *ptrmsg);
+
+/**
+ * @brief Enqueue a block of elements into queue.
+ *
+ * @details One critical section and at most two memcpy calls for the whole block.
+ *   Returns how many elements were queued, the rest did not fit.
+ */
+uint16_t minirtos_Queue_SendBlock(Queue_Descriptor_t *ptrq, const void *ptrmsg, uint16_t number);
+
+/**
+ * @brief Dequeue a block of elements from queue.
+ *
+ * @details One critical section and at most two memcpy calls for the whole block.
+ *   Returns how many elements were removed.
+ */
+uint16_t minirtos_Queue_ReceiveBlock(Queue_Descriptor_t *ptrq, void *ptrmsg, uint16_t number);
+
+/**
+ * @brief Reserve the next free slot of a queue for a zero-copy send.
+ *
+ * @details Returns a pointer into the queue buffer (NULL when full), the element
+ *   is built in place and published by minirtos_Queue_Commit().
+ */
+void *minirtos_Queue_Reserve(Queue_Descriptor_t *ptrq);
+
+/**
+ * @brief Publish the slot returned by minirtos_Queue_Reserve().
+ */
+bool minirtos_Queue_Commit(Queue_Descriptor_t *ptrq);
+
+/**
+ * @brief Get the oldest element of a queue for a zero-copy receive.
+ *
+ * @details Returns a pointer into the queue buffer (NULL when empty), the element
+ *   stays queued until minirtos_Queue_Release().
+ */
+const void *minirtos_Queue_Peek(Queue_Descriptor_t *ptrq);
+
+/**
+ * @brief Free the slot returned by minirtos_Queue_Peek().
+ */
+bool minirtos_Queue_Release(Queue_Descriptor_t *ptrq);
+
+/**
+ * @brief Get number of items currently in queue.
+ *
+ * @details No of elements available in the queue.
+ */
+uint16_t minirtos_Queue_Count(Queue_Descriptor_t *ptrq);
+
+/**
+ * @brief Flush (clear) all contents from the queue.
+ *
+ * @details Resets head, tail, and count so queue is empty.
+ *   Protects structure with critical section for safe use from main/IRQ context.
+ */
+void minirtos_Queue_Flush(Queue_Descriptor_t *ptrq);
+
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1) && (MINIRTOS_CFG_PREEMPTIVE == 1)
+/**
+ * @brief Enqueue data, the calling thread waits for a free slot up to timeout ticks.
+ *
+ * @details Out of a thread it is minirtos_Queue_Send(). MINIRTOS_WAIT_FOREVER never gives up.
+ */
+bool minirtos_Queue_SendWait(Queue_Descriptor_t *ptrq, const void *ptrmsg, uint32_t timeout);
+
+/**
+ * @brief Dequeue data, the calling thread waits for an element up to timeout ticks.
+ *
+ * @details Out of a thread it is minirtos_Queue_Receive(). MINIRTOS_WAIT_FOREVER never gives up.
+ */
+bool minirtos_Queue_ReceiveWait(Queue_Descriptor_t *ptrq, void *ptrmsg, uint32_t timeout);
+#endif
+
+#if (MINIRTOS_CFG_QUEUE_BROADCAST == 1)
+/**
+ * @brief Create/init a broadcast queue, read through Queue_Reader_t cursors.
+ *
+ * @details Sent like any locked queue, it overwrites its oldest element when full.
+ */
+bool minirtos_Queue_CreateBroadcast(Queue_Descriptor_t *ptrq, void *buffer, uint16_t elementSize, uint16_t maxElements);
+
+/**
+ * @brief Attach a reader to a broadcast queue, it gets the elements sent from now on.
+ */
+bool minirtos_Queue_ReaderAttach(Queue_Reader_t *ptrReader, Queue_Descriptor_t *ptrq);
+
+/**
+ * @brief Copy the next element of a broadcast queue for this reader.
+ *
+ * @details A reader which was overtaken by the sender continues with the oldest
+ *   element still queued, minirtos_Queue_ReaderLost() counts the skipped ones.
+ */
+bool minirtos_Queue_ReaderReceive(Queue_Reader_t *ptrReader, void *ptrmsg);
+
+/**
+ * @brief Number of elements the reader has not read yet.
+ */
+uint16_t minirtos_Queue_ReaderCount(Queue_Reader_t *ptrReader);
+
+/**
+ * @brief Number of elements overwritten before the reader got them.
+ */
+uint32_t minirtos_Queue_ReaderLost(const Queue_Reader_t *ptrReader);
+#endif
+
+#if (MINIRTOS_CFG_BLOCK_POOL == 1)
+/**
+ * @brief Create/init a block pool on buffer.
+ *
+ * @details buffer holds numberOfBlocks * MINIRTOS_POOL_BLOCK_SIZE(blockSize) bytes.
+ */
+bool minirtos_Pool_Create(Pool_Descriptor_t *ptrPool, void *buffer, uint16_t blockSize, uint16_t numberOfBlocks);
+
+/**
+ * @brief Take a block from the pool, NULL when the pool is exhausted.
+ *
+ * @details Can be called from interrupts.
+ */
+void *minirtos_Pool_Alloc(Pool_Descriptor_t *ptrPool);
+
+/**
+ * @brief Give a block back to its pool.
+ *
+ * @details Can be called from interrupts, a pointer which is not a block of the pool is refused.
+ */
+bool minirtos_Pool_Free(Pool_Descriptor_t *ptrPool, void *ptrBlock);
+
+/**
+ * @brief Get the number of free blocks of a pool.
+ */
+uint16_t minirtos_Pool_FreeCount(Pool_Descriptor_t *ptrPool);
+
+/**
+ * @brief Get the highest number of blocks which were in use at the same time.
+ */
+uint16_t minirtos_Pool_GetPeak(Pool_Descriptor_t *ptrPool);
+#endif
+
+/**
+ * @brief Get a consistent snapshot of the system tick.
+ *
+ * @details Never torn by the tick interrupt, also with MINIRTOS_CFG_TICK_64BIT.
+ */
+minirtos_Tick_t minirtos_GetTicks(void);
+
+/**
+ * @brief Entry function for the user to initiate scheduler.
+ *
+ * @details This function as to be called before doing anything with the tasker. It
+ * initiates the tasker subsystems. If this funtion is not called before doing
+ * anything with the tasker all functions will return false.
+ *
+ * @note Should be called once from `main()` or before scheduler to start application.
+ */
+void minirtos_Init(void);
+#if (MINIRTOS_CFG_TASK_POOL_SIZE > 0)
+/**
+ * @brief Take a task descriptor from the static pool.
+ *
+ * @details O(1) and interrupt safe, returns NULL when the pool is empty.
+ */
+Task_Descriptor_t *minirtos_TaskPool_Acquire(void);
+
+/**
+ * @brief Give a task descriptor back to the static pool.
+ *
+ * @details O(1) and interrupt safe. The task has to be removed from the scheduler first.
+ */
+bool minirtos_TaskPool_Release(Task_Descriptor_t *ptrTaskDescriptor);
+#endif
+
+/**
+ * @brief Add the task in the scheduler.
+ *
+ * @details Add a task at the end of the circular linked list for the scheduler in O(1).
+ *   A task which is already in the scheduler is refused.
+ */
+
+bool minirtos_AddTask(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus);
+
+/**
+ * @brief Add the task in the scheduler with its first start taskPhase ticks from now.
+ *
+ * @details Spreads tasks sharing an interval over different ticks, the later starts
+ *   keep the offset.
+ */
+bool minirtos_AddTaskPhase(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, uint32_t taskPhase, Task_Status_e taskStatus);
+
+#if (MINIRTOS_CFG_EDF == 1)
+/**
+ * @brief Add an EDF task with its deadline and worst case execution time.
+ *
+ * @details The task is rejected if its utilization (WCET / interval) would bring the
+ *   total utilization above 100%.
+ */
+
+bool minirtos_AddTaskDeadline(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus,
+                    uint32_t taskDeadline, uint32_t taskWcet);
+#endif
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+/**
+ * @brief Add a task whose body is called with a context pointer.
+ *
+ * @details Same as minirtos_AddTask(), the context must not be NULL.
+ */
+
+bool minirtos_AddTaskContext(Task_Descriptor_t *ptrTaskDescriptor, gptr_Task_Context_Function ptrUserTask,
+                    void *ptrContext, uint32_t taskInterval, Task_Status_e taskStatus);
+#endif
+/**
+ * @brief Entry of a task table, for tasks known at build time.
+ *
+ * @details Used as initializer of a Task_Descriptor_t array, e.g.
+ *   Task_Descriptor_t appTasks[] = { MINIRTOS_TASK_ENTRY(Task_LED, 500, TASK_SCHEDULED), ... };
+ */
+#define MINIRTOS_TASK_ENTRY(function, interval, status) \
+    { .taskPointer = (function), .taskInterval = (interval), .taskStatus = (status) }
+
+#if (MINIRTOS_CFG_TASK_CONTEXT == 1)
+/**
+ * @brief Entry of a task table for a task body taking a context, which must not be NULL.
+ */
+#define MINIRTOS_TASK_ENTRY_CONTEXT(function, context, interval, status) \
+    { .taskPointer = (gptr_Task_Function)(function), .taskContext = (context), \
+      .taskInterval = (interval), .taskStatus = (status) }
+#endif
+
+#if (MINIRTOS_CFG_EDF == 1)
+/**
+ * @brief Entry of a task table for an EDF task with its deadline (0 for the interval)
+ *   and worst case execution time, both in milliseconds.
+ */
+#define MINIRTOS_TASK_ENTRY_DEADLINE(function, interval, status, deadline, wcet) \
+    { .taskPointer = (function), .taskInterval = (interval), .taskStatus = (status), \
+      .taskDeadline = (deadline), .taskWcet = (wcet) }
+#endif
+
+/**
+ * @brief Number of entries of a task table.
+ */
+#define MINIRTOS_TASK_COUNT(table)  ((uint8_t)(sizeof(table) / sizeof((table)[0])))
+
+/**
+ * @brief Add a table of tasks declared with MINIRTOS_TASK_ENTRY().
+ *
+ * @details The whole table is linked in one pass or rejected. With EDF the table
+ *   is rejected if its total utilization would overload the CPU.
+ */
+
+bool minirtos_AddTaskTable(Task_Descriptor_t *ptrTaskTable, uint8_t numberOfTasks);
+
+#if (MINIRTOS_CFG_CORES > 1)
+/**
+ * @brief Add the task in the scheduler of a given core.
+ *
+ * @details A task for another core is posted to its mailbox and linked by that core
+ *   on its next scheduler pass. A task refused there gets the status TASK_NOT_FOUND.
+ */
+
+bool minirtos_AddTaskOnCore(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus, uint8_t taskCore);
+
+#if (MINIRTOS_CFG_EDF == 1)
+/**
+ * @brief Add an EDF task with its deadline and WCET in the scheduler of a given core.
+ *
+ * @details The admission test runs against the utilization of taskCore.
+ */
+
+bool minirtos_AddTaskDeadlineOnCore(Task_Descriptor_t *ptrTaskDescriptor, void (*ptrUserTask)(void),
+                    uint32_t taskInterval, Task_Status_e taskStatus,
+                    uint32_t taskDeadline, uint32_t taskWcet, uint8_t taskCore);
+#endif
+#endif
+/**
+ * @brief Remove the task from the scheduler.
+ *
+ * @details This function is used to remove the task from the scheduler in O(1).
+ */
+
+bool minirtos_RemoveTask(Task_Descriptor_t *ptrUserTaskDescriptor);
+
+/**
+ * @brief Pause the task in the scheduler.
+ *
+ * @details This function is used to pause the task on the scheduler.
+ */
+
+bool minirtos_PauseTask(Task_Descriptor_t *ptrTaskDescriptor);
+
+/**
+ * @brief Resume the task in the scheduler.
+ *
+ * @details This function is used to restart a task that has been paused.
+ */
+
+bool minirtos_ResumeTask(Task_Descriptor_t *ptrTaskDescriptor);
+
+/**
+ * @brief Modify the task in the scheduler.
+ *
+ * @details This function is used to modify a task parameters.
+ */
+
+bool minirtos_ModifyTask(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskInterval, Task_Status_e taskStatus);
+
+/**
+ * @brief Get status of the tasks.
+ *
+ * @details Function to check if a task is running or paused etc.
+ */
+
+Task_Status_e minirtos_GetTaskStatus(Task_Descriptor_t *ptrTaskDescriptor);
+
+#if (MINIRTOS_CFG_PRIORITY_LEVELS > 0)
+/**
+ * @brief Set the priority of a task.
+ *
+ * @details 0 is the highest priority, due tasks of the same priority are run round-robin.
+ */
+
+bool minirtos_SetTaskPriority(Task_Descriptor_t *ptrTaskDescriptor, uint8_t taskPriority);
+#endif
+
+#if (MINIRTOS_CFG_TASK_EVENTS == 1)
+/**
+ * @brief Notify events to a task.
+ *
+ * @details The events are or-ed into the task and the task is made due at once.
+ *   Safe from interrupt context.
+ */
+bool minirtos_NotifyTask(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskEvents);
+
+/**
+ * @brief Get the events which woke the running task.
+ *
+ * @details Pending events are handed to the task when it is started, this returns them.
+ */
+uint32_t minirtos_GetTaskEvents(Task_Descriptor_t *ptrTaskDescriptor);
+
+/**
+ * @brief Bind a task to a queue.
+ *
+ * @details Each successful send notifies taskEvents to the task, NULL unbinds.
+ */
+bool minirtos_Queue_BindTask(Queue_Descriptor_t *ptrq, Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskEvents);
+#endif
+
+#if (MINIRTOS_CFG_TASK_STATS == 1)
+/**
+ * @brief Get a snapshot of the statistics of a task.
+ *
+ * @details The copy is taken in a critical section, so it is consistent.
+ */
+bool minirtos_GetTaskStats(Task_Descriptor_t *ptrTaskDescriptor, Task_Stats_t *ptrStats);
+
+/**
+ * @brief Reset the statistics of a task.
+ */
+bool minirtos_ResetTaskStats(Task_Descriptor_t *ptrTaskDescriptor);
+#endif
+
+/**
+ * @brief Scheduler.
+ *
+ * @details Scheduling. This runs the kernel itself.
+ */
+
+void minirtos_Scheduler(void);
+
+#if (MINIRTOS_CFG_TICKLESS_IDLE == 1)
+/**
+ * @brief Install the idle hook.
+ *
+ * @details The hook is called each time the scheduler has nothing to run, before it goes to sleep.
+ */
+void minirtos_SetIdleHook(gptr_Idle_Hook ptrIdleHook);
+
+/**
+ * @brief Install the tickless sleep hook.
+ *
+ * @details Replaces the default SysTick based sleep, e.g. by a low-power timer.
+ */
+void minirtos_SetSleepHook(gptr_Sleep_Hook ptrSleepHook);
+
+/**
+ * @brief Default tickless sleep hook based on SysTick.
+ *
+ * @details Stretches the SysTick period over the idle time, executes WFI and
+ *   returns the number of complete ticks spent sleeping.
+ */
+uint32_t minirtos_SysTickSleep(uint32_t expectedTicks);
+#endif
+
+#if (MINIRTOS_CFG_HRTIMER == 1)
+/**
+ * @brief Start a high resolution timer task.
+ *
+ * @details The callback runs from the timer compare interrupt every taskInterval counts,
+ *   the first time taskInterval counts from now. A callback may restart its own
+ *   timer task with minirtos_HrTimer_Remove() then minirtos_HrTimer_Add().
+ */
+bool minirtos_HrTimer_Add(HrTask_Descriptor_t *ptrHrTask, gptr_Task_Function ptrUserTask, uint32_t taskInterval);
+
+/**
+ * @brief Stop a high resolution timer task.
+ */
+bool minirtos_HrTimer_Remove(HrTask_Descriptor_t *ptrHrTask);
+
+/**
+ * @brief Compare interrupt handler of the high resolution timer.
+ *
+ * @details Runs the due timer tasks and programs the next compare.
+ */
+void minirtos_HrTimer_IRQHandler(void);
+#endif
+
+#if (MINIRTOS_CFG_SW_TIMERS == 1)
+/**
+ * @brief Start or restart a software timer.
+ *
+ * @details The callback runs from the scheduler timeout ticks from now (at least 1),
+ *   then every period ticks unless period is 0. O(1), can be called from interrupt context.
+ */
+bool minirtos_Timer_Start(Timer_Descriptor_t *ptrTimer, gptr_Timer_Callback ptrCallback,
+                          uint32_t timeout, uint32_t period);
+
+/**
+ * @brief Start a software timer again with its last timeout and period.
+ */
+bool minirtos_Timer_Restart(Timer_Descriptor_t *ptrTimer);
+
+/**
+ * @brief Stop a software timer, O(1).
+ */
+bool minirtos_Timer_Stop(Timer_Descriptor_t *ptrTimer);
+
+/**
+ * @brief Check whether a software timer is running.
+ */
+bool minirtos_Timer_IsActive(const Timer_Descriptor_t *ptrTimer);
+#endif
+
+#if (MINIRTOS_CFG_DEFER_QUEUE_SIZE > 0)
+/**
+ * @brief Post a call to be made by the scheduler of the calling core.
+ *
+ * @details For interrupt handlers, returns false when the ring is full.
+ *   The call runs before the next task, in posting order.
+ */
+bool minirtos_Defer(gptr_Defer_Function ptrFunction, void *ptrArgument);
+#endif
+
+#if (MINIRTOS_CFG_TRACE_SIZE > 0)
+/**
+ * @brief Copy the recorded trace events of the calling core out of the ring.
+ *
+ * @details A batch starts with a MINIRTOS_TRACE_SYNC event, then a MINIRTOS_TRACE_LOST
+ *   event if events were dropped. Returns 0 when there is nothing to send.
+ */
+uint16_t minirtos_Trace_Read(Trace_Event_t *ptrEvents, uint16_t maxEvents);
+
+/**
+ * @brief Record the entry of the running interrupt handler.
+ */
+void minirtos_Trace_IsrEnter(void);
+
+/**
+ * @brief Record the exit of the running interrupt handler.
+ */
+void minirtos_Trace_IsrExit(void);
+
+/**
+ * @brief Record an application event with a 24 bit value.
+ */
+void minirtos_Trace_User(uint32_t value);
+#endif
+
+#if (MINIRTOS_CFG_TASK_BUDGET == 1)
+/**
+ * @brief Set the execution budget of a task.
+ *
+ * @details 0 removes the budget, the task is then no longer watched by the watchdog.
+ */
+bool minirtos_SetTaskBudget(Task_Descriptor_t *ptrTaskDescriptor, uint32_t taskBudget);
+
+/**
+ * @brief Install the budget overrun hook, called from the SysTick interrupt.
+ */
+void minirtos_SetBudgetHook(gptr_Budget_Hook ptrBudgetHook);
+
+/**
+ * @brief Install the watchdog hook, called once every watched task checked in.
+ */
+void minirtos_SetWatchdogHook(gptr_Watchdog_Hook ptrWatchdogHook);
+
+/**
+ * @brief Budget tick, to be called from the SysTick handler after incrementing glbSysTicks.
+ */
+void minirtos_Budget_Tick(void);
+#endif
+
+#if (MINIRTOS_CFG_COROUTINES == 1)
+/**
+ * @brief Plan the next dispatch of a task ticks from now.
+ *
+ * @details Used by MINIRTOS_CO_DELAY(), replaces the planning done from the task interval.
+ */
+bool minirtos_Co_Delay(Task_Descriptor_t *ptrTaskDescriptor, uint32_t ticks);
+
+/**
+ * @brief Start of a coroutine task body.
+ *
+ * @details MINIRTOS_CO_BEGIN() and MINIRTOS_CO_END() enclose the whole body, ptrTask is
+ *   the descriptor of the task itself. The body must not use switch statements
+ *   around the MINIRTOS_CO_xxx points, __LINE__ is stored in 16 bits.
+ */
+#define MINIRTOS_CO_BEGIN(ptrTask)          switch ((ptrTask)->coLine) { case 0:
+
+/**
+ * @brief End of a coroutine task body, the next dispatch starts it from the beginning.
+ */
+#define MINIRTOS_CO_END(ptrTask)            } (ptrTask)->coLine = 0
+
+/**
+ * @brief Give the CPU to the other tasks and resume here on the next scheduler pass.
+ */
+#define MINIRTOS_CO_YIELD(ptrTask)          do { (void)minirtos_Co_Delay((ptrTask), 0); \
+                                                 (ptrTask)->coLine = __LINE__; return; case __LINE__:; } while (0)
+
+/**
+ * @brief Resume here ticks from now.
+ */
+#define MINIRTOS_CO_DELAY(ptrTask, ticks)   do { (void)minirtos_Co_Delay((ptrTask), (ticks)); \
+                                                 (ptrTask)->coLine = __LINE__; return; case __LINE__:; } while (0)
+
+/**
+ * @brief Resume here once condition is true, it is evaluated on each dispatch of the task.
+ */
+#define MINIRTOS_CO_WAIT_UNTIL(ptrTask, condition) \
+                                            do { (ptrTask)->coLine = __LINE__; case __LINE__: \
+                                                 if (!(condition)) { return; } } while (0)
+
+/**
+ * @brief Resume here once an element has been received from the queue into ptrmsg.
+ */
+#define MINIRTOS_CO_WAIT_QUEUE(ptrTask, ptrq, ptrmsg) \
+                                            MINIRTOS_CO_WAIT_UNTIL((ptrTask), minirtos_Queue_Receive((ptrq), (ptrmsg)))
+
+/**
+ * @brief Leave the body, the next dispatch starts it from the beginning.
+ */
+#define MINIRTOS_CO_RESTART(ptrTask)        do { (ptrTask)->coLine = 0; return; } while (0)
+
+#if (MINIRTOS_CFG_QUEUE_BLOCKING == 1)
+/**
+ * @brief One attempt of MINIRTOS_CO_SEND(), parks the task on a full queue.
+ */
+Queue_Wait_e minirtos_Co_Send(Task_Descriptor_t *ptrTaskDescriptor, Queue_Descriptor_t *ptrq,
+                              const void *ptrmsg, uint32_t timeout);
+
+/**
+ * @brief One attempt of MINIRTOS_CO_RECEIVE(), parks the task on an empty queue.
+ */
+Queue_Wait_e minirtos_Co_Receive(Task_Descriptor_t *ptrTaskDescriptor, Queue_Descriptor_t *ptrq,
+                                 void *ptrmsg, uint32_t timeout);
+
+/**
+ * @brief Send ptrmsg, resume here once it is queued or timeout ticks elapsed.
+ *
+ * @details result (a Queue_Wait_e) is QUEUE_WAIT_DONE or QUEUE_WAIT_TIMEOUT. The task
+ *   is not dispatched while parked, ptrmsg and timeout are evaluated on each attempt.
+ */
+#define MINIRTOS_CO_SEND(ptrTask, ptrq, ptrmsg, timeout, result) \
+                                            do { (ptrTask)->waitStart = minirtos_GetTicks(); \
+                                                 (ptrTask)->coLine = __LINE__; case __LINE__: \
+                                                 (result) = minirtos_Co_Send((ptrTask), (ptrq), (ptrmsg), (timeout)); \
+                                                 if ((result) == QUEUE_WAIT_PARKED) { return; } } while (0)
+
+/**
+ * @brief Receive into ptrmsg, resume here once an element came or timeout ticks elapsed.
+ *
+ * @details Same rules as MINIRTOS_CO_SEND().
+ */
+#define MINIRTOS_CO_RECEIVE(ptrTask, ptrq, ptrmsg, timeout, result) \
+                                            do { (ptrTask)->waitStart = minirtos_GetTicks(); \
+                                                 (ptrTask)->coLine = __LINE__; case __LINE__: \
+                                                 (result) = minirtos_Co_Receive((ptrTask), (ptrq), (ptrmsg), (timeout)); \
+                                                 if ((result) == QUEUE_WAIT_PARKED) { return; } } while (0)
+#endif
+#endif
+
+#if (MINIRTOS_CFG_PREEMPTIVE == 1)
+/**
+ * @brief Create a preemptive thread.
+ *
+ * @details The thread gets ready at once and preempts the caller if it has a higher priority.
+ */
+bool minirtos_Thread_Create(Thread_Descriptor_t *ptrThread, gptr_Task_Function ptrUserThread,
+                            uint32_t *ptrStack, uint32_t stackWords, uint8_t threadPriority);
+
+/**
+ * @brief Put the running thread to sleep for a number of ticks.
+ */
+void minirtos_Thread_Delay(uint32_t ticks);
+
+/**
+ * @brief Block the running thread until it is notified.
+ */
+void minirtos_Thread_Wait(void);
+
+/**
+ * @brief Notify a thread, from any context.
+ *
+ * @details A waiting thread gets ready and preempts the caller if it has a higher priority.
+ */
+bool minirtos_Thread_Notify(Thread_Descriptor_t *ptrThread);
+
+/**
+ * @brief Thread tick, to be called from the SysTick handler after incrementing glbSysTicks.
+ */
+void minirtos_Thread_Tick(void);
+
+/**
+ * @brief Get the running thread, NULL in the cooperative context.
+ */
+Thread_Descriptor_t *minirtos_Thread_Self(void);
+
+/**
+ * @brief PendSV exception handler doing the context switch.
+ */
+void PendSV_Handler(void);
+#endif
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,121 @@
+/**
+ * \file           cmsis_gcc.h
+ * \brief          Host port, stand-in for the CMSIS core intrinsics
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+
+#ifndef MINIRTOS_HOST_CMSIS_GCC_H_
+#define MINIRTOS_HOST_CMSIS_GCC_H_
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#include <stdint.h>
+/*****************************************************************************/
+/* Global Variables                                                          */
+/*****************************************************************************/
+extern volatile uint32_t glbHostPrimask; /** Simulated PRIMASK, 1 inside the critical sections **/
+/*****************************************************************************/
+/* Private Defines                                                           */
+/*****************************************************************************/
+/**
+ * @brief Cycle counter of the task statistics.
+ *
+ * @details The host has no DWT, the statistics count nanoseconds of the monotonic
+ *   clock instead (wrapping at 32 bit like the cycle counter).
+ */
+#ifndef MINIRTOS_STATS_CYCLES
+#define MINIRTOS_STATS_CYCLES()     minirtos_Host_Cycles()
+#endif
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+/**
+ * @brief Free running 32 bit counter in nanoseconds.
+ */
+uint32_t minirtos_Host_Cycles(void);
+
+/*
+ * The host has no interrupts: PRIMASK is only recorded so the critical sections
+ * nest as on the target, the barriers order the memory accesses of the threads
+ * which simulate the interrupt handlers, WFI and SEV do nothing.
+ */
+static inline uint32_t __get_PRIMASK(void)
+{
+    return glbHostPrimask;
+}
+
+static inline void __set_PRIMASK(uint32_t priMask)
+{
+    glbHostPrimask = priMask;
+}
+
+static inline void __DMB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __DSB(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __ISB(void)
+{
+    __atomic_signal_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __WFI(void)
+{
+}
+
+static inline void __SEV(void)
+{
+}
+
+static inline uint8_t __CLZ(uint32_t value)
+{
+    return (value == 0U) ? 32U : (uint8_t)__builtin_clz(value);
+}
+
+static inline uint32_t __get_IPSR(void)
+{
+    /* Always thread mode */
+    return 0U;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* MINIRTOS_HOST_CMSIS_GCC_H_ */
@@ -0,0 +1,58 @@
+/**
+ * \file           minirtos_port.c
+ * \brief          Host port source file
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#define _POSIX_C_SOURCE 199309L
+#include <time.h>
+#include "cmsis_gcc.h"
+/*****************************************************************************/
+/* Private Variables                                                         */
+/*****************************************************************************/
+volatile uint32_t glbHostPrimask; /* Simulated PRIMASK */
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+/*****************************************************************************
+ * @brief Free running 32 bit counter in nanoseconds.
+ *
+ * @details Replaces the DWT cycle counter of the task statistics.
+ *
+ * @return Monotonic time in nanoseconds, modulo 2^32
+ *****************************************************************************/
+uint32_t minirtos_Host_Cycles(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t)(((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec);
+}
+/************************************END*****************************************/
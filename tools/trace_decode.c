@@ -0,0 +1,317 @@
+/**
+ * \file           trace_decode.c
+ * \brief          Host tool turning a MiniRTOS trace stream into a timeline
+ */
+
+/*
+ * Copyright (c) 2021 Sourabh Potdar
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sub-license, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * Author:          Sourabh Potdar
+ */
+/*****************************************************************************/
+/* Include Files                                                             */
+/*****************************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <unistd.h>
+#include "minirtos.h"
+/*****************************************************************************/
+/* Private Defines                                                           */
+/*****************************************************************************/
+#define DECODE_EVENT_SIZE   8U      /* Bytes of a Trace_Event_t in the stream */
+#define DECODE_MAX_NAMES    1024U   /* Symbols kept from the nm output */
+#define DECODE_MAX_RUNNING  64U     /* Objects whose start is remembered */
+/*****************************************************************************/
+/* Private Variables                                                         */
+/*****************************************************************************/
+typedef struct {
+    uint32_t object;
+    char name[48];
+} Decode_Name_t;
+
+typedef struct {
+    uint32_t object;
+    uint64_t start;
+} Decode_Running_t;
+
+static Decode_Name_t glbNames[DECODE_MAX_NAMES];
+static uint16_t glbNameCount;
+static Decode_Running_t glbRunning[DECODE_MAX_RUNNING];
+static double glbTicksPerUs = 1.0;
+static bool glbJson;
+static bool glbFirstJson = true;
+/*****************************************************************************/
+/* Private Functions                                                         */
+/*****************************************************************************/
+static uint32_t decode_Le32(const uint8_t *ptrBytes)
+{
+    return (uint32_t)ptrBytes[0] | ((uint32_t)ptrBytes[1] << 8) | ((uint32_t)ptrBytes[2] << 16) |
+           ((uint32_t)ptrBytes[3] << 24);
+}
+
+static bool decode_IsSync(const uint8_t *ptrBytes)
+{
+    return decode_Le32(&ptrBytes[4]) ==
+           (((uint32_t)MINIRTOS_TRACE_SYNC << MINIRTOS_TRACE_TYPE_SHIFT) | MINIRTOS_TRACE_SYNC_MAGIC);
+}
+
+static bool decode_IsKnown(uint8_t eventType)
+{
+    return ((eventType >= MINIRTOS_TRACE_TASK_START) && (eventType <= MINIRTOS_TRACE_USER)) ||
+           (eventType == MINIRTOS_TRACE_LOST) || (eventType == MINIRTOS_TRACE_SYNC);
+}
+
+/* Symbols of the target, "nm" output lines: address, type letter, name */
+static void decode_LoadNames(const char *ptrPath)
+{
+    FILE *ptrFile = fopen(ptrPath, "r");
+    char line[256];
+
+    if (ptrFile == NULL)
+    {
+        perror(ptrPath);
+        exit(EXIT_FAILURE);
+    }
+    while ((fgets(line, sizeof(line), ptrFile) != NULL) && (glbNameCount < DECODE_MAX_NAMES))
+    {
+        unsigned long address;
+        char type;
+        char name[48];
+
+        if (sscanf(line, "%lx %c %47s", &address, &type, name) == 3)
+        {
+            glbNames[glbNameCount].object = (uint32_t)address & MINIRTOS_TRACE_OBJECT_MASK;
+            memcpy(glbNames[glbNameCount].name, name, sizeof(name));
+            glbNameCount++;
+        }
+    }
+    fclose(ptrFile);
+}
+
+static const char *decode_Name(uint8_t eventType, uint32_t object, char *ptrBuffer, size_t size)
+{
+    if ((eventType == MINIRTOS_TRACE_ISR_ENTER) || (eventType == MINIRTOS_TRACE_ISR_EXIT))
+    {
+        (void)snprintf(ptrBuffer, size, "IRQ%d", (int)object - 16);
+        return ptrBuffer;
+    }
+    if ((eventType == MINIRTOS_TRACE_USER) || (eventType == MINIRTOS_TRACE_LOST))
+    {
+        (void)snprintf(ptrBuffer, size, "%lu", (unsigned long)object);
+        return ptrBuffer;
+    }
+    for (uint16_t index = 0; index < glbNameCount; index++)
+    {
+        if (glbNames[index].object == object)
+        {
+            return glbNames[index].name;
+        }
+    }
+    (void)snprintf(ptrBuffer, size, "0x%06lx", (unsigned long)object);
+    return ptrBuffer;
+}
+
+/* Remember the start of a task or interrupt, returns the start of the matching run on the end */
+static bool decode_Running(uint32_t object, uint64_t time, bool start, uint64_t *ptrStart)
+{
+    for (uint8_t index = 0; index < DECODE_MAX_RUNNING; index++)
+    {
+        if (start && (glbRunning[index].object == 0))
+        {
+            glbRunning[index].object = object | 0x80000000UL;
+            glbRunning[index].start = time;
+            return true;
+        }
+        if (!start && (glbRunning[index].object == (object | 0x80000000UL)))
+        {
+            glbRunning[index].object = 0;
+            *ptrStart = glbRunning[index].start;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void decode_Json(const char *ptrName, char phase, uint32_t thread, double timeUs)
+{
+    printf("%s\n  {\"name\": \"%s\", \"ph\": \"%c\", \"ts\": %.3f, \"pid\": 0, \"tid\": %lu%s}",
+           glbFirstJson ? "" : ",", ptrName, phase, timeUs, (unsigned long)thread, (phase == 'i') ? ", \"s\": \"t\"" : "");
+    glbFirstJson = false;
+}
+
+static void decode_Event(uint8_t eventType, uint32_t object, uint64_t time)
+{
+    static const char *const typeName[] = {
+        "", "task start", "task end", "queue send", "queue full",
+        "queue receive", "queue empty", "isr enter", "isr exit", "user"
+    };
+    const char *ptrType = (eventType == MINIRTOS_TRACE_LOST) ? "lost" : typeName[eventType & 0x0FU];
+    double timeUs = (double)time / glbTicksPerUs;
+    char buffer[48];
+    const char *ptrName = decode_Name(eventType, object, buffer, sizeof(buffer));
+    uint64_t start = 0;
+    bool started = (eventType == MINIRTOS_TRACE_TASK_START) || (eventType == MINIRTOS_TRACE_ISR_ENTER);
+    bool ended = (eventType == MINIRTOS_TRACE_TASK_END) || (eventType == MINIRTOS_TRACE_ISR_EXIT);
+    bool matched = false;
+
+    if (eventType == MINIRTOS_TRACE_SYNC)
+    {
+        /* Only marks the batches */
+        return;
+    }
+    if (started || ended)
+    {
+        matched = decode_Running(object, time, started, &start);
+    }
+    if (glbJson)
+    {
+        uint32_t thread = ((eventType == MINIRTOS_TRACE_ISR_ENTER) || (eventType == MINIRTOS_TRACE_ISR_EXIT)) ? 1U : 0U;
+
+        decode_Json(ptrName, started ? 'B' : (ended ? 'E' : 'i'), (started || ended) ? thread : 2U, timeUs);
+        return;
+    }
+    printf("%14.3f  %-14s %s", timeUs, ptrType, ptrName);
+    if (ended && matched)
+    {
+        printf("  (%.3f us)", (double)(time - start) / glbTicksPerUs);
+    }
+    printf("\n");
+}
+
+static void decode_Usage(const char *ptrProgram)
+{
+    fprintf(stderr, "usage: %s [-f ticks_per_us] [-n nm_output] [-j] trace.bin\n"
+                    "  -f  timestamp ticks per microsecond (CPU MHz for the DWT), default 1\n"
+                    "  -n  symbols of the target (nm firmware.elf) to name tasks and queues\n"
+                    "  -j  Chrome trace event JSON (chrome://tracing, ui.perfetto.dev)\n", ptrProgram);
+    exit(EXIT_FAILURE);
+}
+/*****************************************************************************/
+/* Public Functions                                                          */
+/*****************************************************************************/
+int main(int argc, char *argv[])
+{
+    FILE *ptrFile;
+    uint8_t *ptrStream = NULL;
+    size_t length = 0;
+    size_t offset = 0;
+    uint64_t time = 0;
+    uint32_t lastStamp = 0;
+    bool synced = false;
+    bool decoded = false;
+    int option;
+
+    while ((option = getopt(argc, argv, "f:n:j")) != -1)
+    {
+        switch (option)
+        {
+        case 'f':
+            glbTicksPerUs = strtod(optarg, NULL);
+            break;
+        case 'n':
+            decode_LoadNames(optarg);
+            break;
+        case 'j':
+            glbJson = true;
+            break;
+        default:
+            decode_Usage(argv[0]);
+            break;
+        }
+    }
+    if ((optind != (argc - 1)) || !(glbTicksPerUs > 0.0))
+    {
+        decode_Usage(argv[0]);
+    }
+
+    ptrFile = fopen(argv[optind], "rb");
+    if (ptrFile == NULL)
+    {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+    for (;;)
+    {
+        uint8_t *ptrGrown = realloc(ptrStream, length + 4096U);
+        size_t got;
+
+        if (ptrGrown == NULL)
+        {
+            fprintf(stderr, "out of memory\n");
+            return EXIT_FAILURE;
+        }
+        ptrStream = ptrGrown;
+        got = fread(&ptrStream[length], 1, 4096U, ptrFile);
+        length += got;
+        if (got < 4096U)
+        {
+            break;
+        }
+    }
+    fclose(ptrFile);
+
+    if (glbJson)
+    {
+        printf("[");
+    }
+    while ((offset + DECODE_EVENT_SIZE) <= length)
+    {
+        const uint8_t *ptrEvent = &ptrStream[offset];
+        uint32_t stamp = decode_Le32(ptrEvent);
+        uint32_t eventData = decode_Le32(&ptrEvent[4]);
+        uint8_t eventType = (uint8_t)(eventData >> MINIRTOS_TRACE_TYPE_SHIFT);
+
+        if (!synced || !decode_IsKnown(eventType))
+        {
+            /* Look for the next batch, byte by byte */
+            if (!decode_IsSync(ptrEvent))
+            {
+                offset++;
+                synced = false;
+                continue;
+            }
+            if (decoded)
+            {
+                fprintf(stderr, "resynchronized at byte %zu\n", offset);
+            }
+            synced = true;
+        }
+        /* 32 bit timestamps, the gaps between events are shorter than a wrap */
+        if (decoded)
+        {
+            time += (uint32_t)(stamp - lastStamp);
+        }
+        lastStamp = stamp;
+        decoded = true;
+        decode_Event(eventType, eventData & MINIRTOS_TRACE_OBJECT_MASK, time);
+        offset += DECODE_EVENT_SIZE;
+    }
+    if (glbJson)
+    {
+        printf("\n]\n");
+    }
+    free(ptrStream);
+
+    return EXIT_SUCCESS;
+}
+/************************************END*****************************************/